@@ -0,0 +1,66 @@
+// AGP Aperture Buffers
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <AGPBuffer.hpp>
+#include <GPUDriversAMD/RavenIPOffset.hpp>
+#include <Headers/kern_util.hpp>
+#include <IOKit/IOBufferMemoryDescriptor.h>
+#include <NRed.hpp>
+#include <Regs/MMHUB.hpp>
+
+// The aperture is in 16MiB units, the top register holds the last unit inside it.
+static_assert(agpMCAddress(0x12345000, 0x1000, 0xF400000000, 0xF4FFFFFFFF, 0) == 0xF412345000);
+static_assert(agpMCAddress(0x12345000, 0x1000, 0xF400000000, 0xF4FFFFFFFF, 0x10000000) == 0xF402345000);
+static_assert(agpMCAddress(0xFFFFE000, 0x2000, 0xF400000000, 0xF4FFFFFFFF, 0) == 0xF4FFFFE000);
+static_assert(agpMCAddress(0xFFFFF000, 0x2000, 0xF400000000, 0xF4FFFFFFFF, 0) == 0);
+static_assert(agpMCAddress(0x10000000000, 0x1000, 0xF400000000, 0xF4FFFFFFFF, 0) == 0);
+static_assert(agpMCAddress(0x1000, 0x1000, 0xFFFFFF000000, 0, 0) == 0);
+
+static UInt64 readAGPReg(const UInt32 reg)
+{
+    return static_cast<UInt64>(NRed::singleton().readReg32(MMHUB_BASE_0 + reg) & MC_VM_AGP_ADDR_MASK)
+           << MC_VM_AGP_ADDR_SHIFT;
+}
+
+bool AGPBuffer::allocate(const size_t size)
+{
+    if (this->memory != nullptr) { return true; }
+
+    const auto agpBot  = readAGPReg(MC_VM_AGP_BOT);
+    const auto agpTop  = readAGPReg(MC_VM_AGP_TOP) | ((1ULL << MC_VM_AGP_ADDR_SHIFT) - 1);
+    const auto agpBase = readAGPReg(MC_VM_AGP_BASE);
+    if (agpBot > agpTop) {
+        SYSLOG("AGPBuffer", "AGP aperture is disabled");
+        return false;
+    }
+
+    // Caching has to be off as nothing snoops on the firmware's writes.
+    const auto  limit  = agpBase + (agpTop - agpBot);
+    auto* const memory = IOBufferMemoryDescriptor::inTaskWithPhysicalMask(
+        kernel_task, kIODirectionInOut | kIOMemoryPhysicallyContiguous | kIOMapInhibitCache, size,
+        limit == ~0ULL ? limit : (1ULL << (63 - __builtin_clzll(limit + 1))) - 1);
+    if (memory == nullptr) { return false; }
+
+    const auto mcAddr = agpMCAddress(memory->getPhysicalSegment(0, nullptr, kIOMemoryMapperNone), size, agpBot,
+                                     agpTop, agpBase);
+    if (mcAddr == 0) {
+        SYSLOG("AGPBuffer", "Allocation is outside of the AGP aperture 0x%llX-0x%llX", agpBot, agpTop);
+        memory->release();
+        return false;
+    }
+    this->memory = memory;
+    this->mcAddr = mcAddr;
+    return true;
+}
+
+void AGPBuffer::free()
+{
+    OSSafeReleaseNULL(this->memory);
+    this->mcAddr = 0;
+}
+
+void* AGPBuffer::getBytes() const { return this->memory->getBytesNoCopy(); }
+
+size_t AGPBuffer::getLength() const { return this->memory->getLength(); }
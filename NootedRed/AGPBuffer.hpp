@@ -0,0 +1,36 @@
+// AGP Aperture Buffers
+// System memory the GPU and its firmware reach by MC address through the MMHUB AGP aperture, without a GART mapping.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOTypes.h>
+
+class IOBufferMemoryDescriptor;
+
+// Translates like `amdgpu_gmc_agp_addr`, so the buffer has to be physically contiguous and uncached.
+constexpr UInt64 agpMCAddress(const UInt64 physAddr, const UInt64 size, const UInt64 agpBot, const UInt64 agpTop,
+                              const UInt64 agpBase)
+{
+    if (agpBot > agpTop || physAddr < agpBase) { return 0; }
+    const auto mcAddr = agpBot + (physAddr - agpBase);
+    if (mcAddr < agpBot || mcAddr + size - 1 > agpTop) { return 0; }
+    return mcAddr;
+}
+
+class AGPBuffer
+{
+    IOBufferMemoryDescriptor* memory{nullptr};
+    UInt64                    mcAddr{0};
+
+public:
+    // Fails if the aperture is disabled or doesn't cover the allocation.
+    bool allocate(size_t size);
+    void free();
+
+    bool   isAllocated() const { return this->memory != nullptr; }
+    UInt64 getMCAddress() const { return this->mcAddr; }
+    void*  getBytes() const;
+    size_t getLength() const;
+};
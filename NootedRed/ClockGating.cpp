@@ -0,0 +1,333 @@
+// Clock Gating
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <ClockGating.hpp>
+#include <GPUDriversAMD/RavenIPOffset.hpp>
+#include <GfxOff.hpp>
+#include <Headers/kern_util.hpp>
+#include <NRed.hpp>
+#include <PenguinWizardry/Wait.hpp>
+#include <Regs/GC.hpp>
+#include <Regs/MMHUB.hpp>
+#include <Regs/SDMA0.hpp>
+#include <pexpert/pexpert.h>
+
+static constexpr UInt32 RLC_SAFE_MODE_TIMEOUT_MS = 100;
+
+static ClockGating moduleInstance;
+
+ClockGating& ClockGating::singleton() { return moduleInstance; }
+
+// Goes through NRed's MMIO mapping. Register offsets include the IP base.
+struct MMIORegisters
+{
+    UInt32 readRegister(const UInt32 reg) const { return NRed::singleton().readReg32(reg); }
+    void   writeRegister(const UInt32 reg, const UInt32 value) const { NRed::singleton().writeReg32(reg, value); }
+};
+
+template<typename R>
+static constexpr void updateReg32(R& regs, const UInt32 reg, const UInt32 clear, const UInt32 set)
+{
+    const auto value = regs.readRegister(reg);
+    const auto data  = (value & ~clear) | set;
+    if (data != value) { regs.writeRegister(reg, data); }
+}
+
+template<typename R>
+static constexpr void applyGfx(R& regs, const UInt32 features, const bool isGC910)
+{
+    if ((features & kCGGfxMGCG) != 0) {
+        UInt32 clear = RLC_CGTT_MGCG_OVERRIDE_GRBM_CGTT_SCLK_OVERRIDE | RLC_CGTT_MGCG_OVERRIDE_GFXIP_MGCG_OVERRIDE
+                       | RLC_CGTT_MGCG_OVERRIDE_CPF_CGTT_SCLK_OVERRIDE;
+        if ((features & (kCGGfxRlcLS | kCGGfxCpLS)) != 0) { clear |= RLC_CGTT_MGCG_OVERRIDE_GFXIP_MGLS_OVERRIDE; }
+        // GC 9.1.0 wants the RLC itself kept out of MGCG.
+        const UInt32 set = isGC910 ? RLC_CGTT_MGCG_OVERRIDE_RLC_CGTT_SCLK_OVERRIDE : 0;
+        updateReg32(regs, GC_BASE_1 + RLC_CGTT_MGCG_OVERRIDE, clear, set);
+
+        if ((features & kCGGfxRlcLS) != 0) {
+            updateReg32(regs, GC_BASE_1 + RLC_MEM_SLP_CNTL, 0, RLC_MEM_SLP_CNTL_RLC_MEM_LS_EN);
+        }
+        if ((features & kCGGfxCpLS) != 0) {
+            updateReg32(regs, GC_BASE_0 + CP_MEM_SLP_CNTL, 0, CP_MEM_SLP_CNTL_CP_MEM_LS_EN);
+        }
+    }
+
+    if ((features & kCGGfxCGCG) != 0) {
+        const bool cgls  = (features & kCGGfxCGLS) != 0;
+        UInt32     clear = RLC_CGTT_MGCG_OVERRIDE_GFXIP_CGCG_OVERRIDE;
+        UInt32     set   = 0;
+        if (cgls) { clear |= RLC_CGTT_MGCG_OVERRIDE_GFXIP_CGLS_OVERRIDE; }
+        else {
+            set |= RLC_CGTT_MGCG_OVERRIDE_GFXIP_CGLS_OVERRIDE;
+        }
+        updateReg32(regs, GC_BASE_1 + RLC_CGTT_MGCG_OVERRIDE, clear, set);
+
+        UInt32 ctrl = RLC_CGCG_CGLS_CTRL_CGCG_EN | (0x36 << RLC_CGCG_CGLS_CTRL_CGCG_GFX_IDLE_THRESHOLD_SHIFT);
+        if (cgls) { ctrl |= RLC_CGCG_CGLS_CTRL_CGLS_EN | (0xF << RLC_CGCG_CGLS_CTRL_CGLS_REP_COMPANSAT_DELAY_SHIFT); }
+        if (regs.readRegister(GC_BASE_1 + RLC_CGCG_CGLS_CTRL) != ctrl) {
+            regs.writeRegister(GC_BASE_1 + RLC_CGCG_CGLS_CTRL, ctrl);
+        }
+
+        // The CP has to go idle for CGCG to kick in, so it can't keep polling the write pointer.
+        updateReg32(regs, GC_BASE_0 + CP_RB_WPTR_POLL_CNTL,
+                    CP_RB_WPTR_POLL_CNTL_POLL_FREQUENCY_MASK | CP_RB_WPTR_POLL_CNTL_IDLE_POLL_COUNT_MASK,
+                    (0x100 << CP_RB_WPTR_POLL_CNTL_POLL_FREQUENCY_SHIFT)
+                        | (0x90 << CP_RB_WPTR_POLL_CNTL_IDLE_POLL_COUNT_SHIFT));
+    }
+}
+
+template<typename R>
+static constexpr void applySdma(R& regs, const UInt32 features)
+{
+    if ((features & kCGSdmaMGCG) != 0) {
+        updateReg32(regs, SDMA0_BASE_0 + SDMA0_CLK_CTRL, SDMA0_CLK_CTRL_SOFT_OVERRIDE_ALL, 0);
+    }
+    if ((features & kCGSdmaLS) != 0) {
+        updateReg32(regs, SDMA0_BASE_0 + SDMA0_POWER_CNTL, 0, SDMA0_POWER_CNTL_MEM_POWER_OVERRIDE);
+    }
+}
+
+template<typename R>
+static constexpr void applyMmhub(R& regs, const UInt32 features)
+{
+    UInt32 set = 0;
+    if ((features & kCGMmhubMGCG) != 0) { set |= ATC_L2_MISC_CG_ENABLE; }
+    if ((features & kCGMmhubLS) != 0) { set |= ATC_L2_MISC_CG_MEM_LS_ENABLE; }
+    if (set != 0) { updateReg32(regs, MMHUB_BASE_0 + ATC_L2_MISC_CG, 0, set); }
+}
+
+namespace ClockGatingTests
+{
+
+    // Remembers every register it was given or written, and the writes in order.
+    struct RegisterLog
+    {
+        static constexpr size_t CAPACITY = 8;
+
+        struct Access
+        {
+            UInt32 reg;
+            UInt32 value;
+        };
+
+        Access state[CAPACITY]{};
+        size_t stateCount{0};
+        Access writes[CAPACITY]{};
+        size_t writeCount{0};
+
+        constexpr UInt32 readRegister(const UInt32 reg) const
+        {
+            for (size_t i = 0; i < this->stateCount; i += 1) {
+                if (this->state[i].reg == reg) { return this->state[i].value; }
+            }
+            return 0;
+        }
+
+        constexpr void writeRegister(const UInt32 reg, const UInt32 value)
+        {
+            this->writes[this->writeCount++] = {reg, value};
+            this->set(reg, value);
+        }
+
+        constexpr RegisterLog& set(const UInt32 reg, const UInt32 value)
+        {
+            for (size_t i = 0; i < this->stateCount; i += 1) {
+                if (this->state[i].reg == reg) {
+                    this->state[i].value = value;
+                    return *this;
+                }
+            }
+            this->state[this->stateCount++] = {reg, value};
+            return *this;
+        }
+
+        template<size_t N>
+        constexpr bool wrote(const Access (&expected)[N]) const
+        {
+            if (this->writeCount != N) { return false; }
+            for (size_t i = 0; i < N; i += 1) {
+                if (this->writes[i].reg != expected[i].reg || this->writes[i].value != expected[i].value) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    constexpr UInt32 kCGCGCtrl =
+        RLC_CGCG_CGLS_CTRL_CGCG_EN | (0x36 << RLC_CGCG_CGLS_CTRL_CGCG_GFX_IDLE_THRESHOLD_SHIFT);
+    constexpr UInt32 kCGLSCtrl =
+        kCGCGCtrl | RLC_CGCG_CGLS_CTRL_CGLS_EN | (0xF << RLC_CGCG_CGLS_CTRL_CGLS_REP_COMPANSAT_DELAY_SHIFT);
+    constexpr UInt32 kWptrPollCntl = 0x00900100;
+
+    // Every override starts out set, like after CAIL's GC init.
+    constexpr bool ravenProgramsEveryGfxFeature()
+    {
+        RegisterLog regs{};
+        regs.set(GC_BASE_1 + RLC_CGTT_MGCG_OVERRIDE, 0xFF);
+        applyGfx(regs, kCGRaven, true);
+        return regs.wrote({
+            {GC_BASE_1 + RLC_CGTT_MGCG_OVERRIDE, 0x9A},
+            {GC_BASE_1 + RLC_MEM_SLP_CNTL, RLC_MEM_SLP_CNTL_RLC_MEM_LS_EN},
+            {GC_BASE_0 + CP_MEM_SLP_CNTL, CP_MEM_SLP_CNTL_CP_MEM_LS_EN},
+            {GC_BASE_1 + RLC_CGTT_MGCG_OVERRIDE, 0x82},
+            {GC_BASE_1 + RLC_CGCG_CGLS_CTRL, kCGLSCtrl},
+            {GC_BASE_0 + CP_RB_WPTR_POLL_CNTL, kWptrPollCntl},
+        });
+    }
+    static_assert(ravenProgramsEveryGfxFeature());
+
+    // RLC light sleep hangs Renoir.
+    constexpr bool renoirLeavesRLCLightSleepAlone()
+    {
+        RegisterLog regs{};
+        regs.set(GC_BASE_1 + RLC_CGTT_MGCG_OVERRIDE, 0xFF);
+        applyGfx(regs, kCGRenoir, false);
+        return regs.wrote({
+            {GC_BASE_1 + RLC_CGTT_MGCG_OVERRIDE, 0x9A},
+            {GC_BASE_0 + CP_MEM_SLP_CNTL, CP_MEM_SLP_CNTL_CP_MEM_LS_EN},
+            {GC_BASE_1 + RLC_CGTT_MGCG_OVERRIDE, 0x82},
+            {GC_BASE_1 + RLC_CGCG_CGLS_CTRL, kCGLSCtrl},
+            {GC_BASE_0 + CP_RB_WPTR_POLL_CNTL, kWptrPollCntl},
+        });
+    }
+    static_assert(renoirLeavesRLCLightSleepAlone());
+
+    constexpr bool cgcgWithoutCGLSKeepsTheOverride()
+    {
+        RegisterLog regs{};
+        regs.set(GC_BASE_1 + RLC_CGTT_MGCG_OVERRIDE, RLC_CGTT_MGCG_OVERRIDE_GFXIP_CGCG_OVERRIDE);
+        applyGfx(regs, kCGGfxCGCG, true);
+        return regs.wrote({
+            {GC_BASE_1 + RLC_CGTT_MGCG_OVERRIDE, RLC_CGTT_MGCG_OVERRIDE_GFXIP_CGLS_OVERRIDE},
+            {GC_BASE_1 + RLC_CGCG_CGLS_CTRL, kCGCGCtrl},
+            {GC_BASE_0 + CP_RB_WPTR_POLL_CNTL, kWptrPollCntl},
+        });
+    }
+    static_assert(cgcgWithoutCGLSKeepsTheOverride());
+
+    // Reapplying on top of what is already there mustn't touch anything.
+    constexpr bool reapplyingWritesNothing()
+    {
+        RegisterLog regs{};
+        regs.set(GC_BASE_1 + RLC_CGTT_MGCG_OVERRIDE, 0x9A);
+        applyGfx(regs, kCGAll, true);
+        applySdma(regs, kCGAll);
+        applyMmhub(regs, kCGAll);
+        const auto writes = regs.writeCount;
+        applyGfx(regs, kCGAll, true);
+        applySdma(regs, kCGAll);
+        applyMmhub(regs, kCGAll);
+        return writes == 7 && regs.writeCount == writes;
+    }
+    static_assert(reapplyingWritesNothing());
+
+    constexpr bool sdmaAndMmhub()
+    {
+        RegisterLog regs{};
+        regs.set(SDMA0_BASE_0 + SDMA0_CLK_CTRL, SDMA0_CLK_CTRL_SOFT_OVERRIDE_ALL | 0x100);
+        applySdma(regs, kCGSdmaAll);
+        applyMmhub(regs, kCGMmhubAll);
+        return regs.wrote({
+            {SDMA0_BASE_0 + SDMA0_CLK_CTRL, 0x100},
+            {SDMA0_BASE_0 + SDMA0_POWER_CNTL, SDMA0_POWER_CNTL_MEM_POWER_OVERRIDE},
+            {MMHUB_BASE_0 + ATC_L2_MISC_CG, ATC_L2_MISC_CG_ENABLE | ATC_L2_MISC_CG_MEM_LS_ENABLE},
+        });
+    }
+    static_assert(sdmaAndMmhub());
+
+    constexpr bool emptyMaskWritesNothing()
+    {
+        RegisterLog regs{};
+        applyGfx(regs, 0, true);
+        applySdma(regs, 0);
+        applyMmhub(regs, 0);
+        return regs.writeCount == 0;
+    }
+    static_assert(emptyMaskWritesNothing());
+
+}    // namespace ClockGatingTests
+
+void ClockGating::init()
+{
+    if (this->enabled || !checkKernelArgument("-NRedCG")) { return; }
+
+    this->enabled = true;
+    SYSLOG("ClockGating", "Enabled");
+}
+
+void ClockGating::apply()
+{
+    if (!this->enabled) { return; }
+
+    const auto& attributes = NRed::singleton().getAttributes();
+    if (attributes.isRenoir()) { this->mask = kCGRenoir; }
+    else if (attributes.isRaven2()) {
+        this->mask = kCGRaven2;
+    }
+    else if (attributes.isPicasso()) {
+        this->mask = kCGPicasso;
+    }
+    else {
+        this->mask = kCGRaven;
+    }
+    if (PE_parse_boot_argn("NRedCGMask", &this->mask, sizeof(this->mask))) { this->mask &= kCGAll; }
+
+    this->applied = true;
+    this->program();
+}
+
+void ClockGating::reapply()
+{
+    if (this->applied) { this->program(); }
+}
+
+void ClockGating::program()
+{
+    const auto&   nred    = NRed::singleton();
+    const auto&   attr    = nred.getAttributes();
+    MMIORegisters regs{};
+    this->features = this->mask;
+
+    const GfxOffGuard gfxOffGuard;
+    if ((this->features & kCGGfxAll) != 0) {
+        if (enterRLCSafeMode()) {
+            applyGfx(regs, this->features, !attr.isRaven2() && !attr.isRenoir());
+            exitRLCSafeMode();
+        }
+        else {
+            SYSLOG("ClockGating", "RLC is not running or did not enter safe mode, leaving GC alone");
+            this->features &= ~kCGGfxAll;
+        }
+    }
+    // CAIL's SDMA init rewrites these once it un-halts F32, anything set before that would be lost.
+    if ((this->features & kCGSdmaAll) != 0
+        && (nred.readReg32(SDMA0_BASE_0 + SDMA0_F32_CNTL) & SDMA0_F32_CNTL_HALT) != 0)
+    {
+        SYSLOG("ClockGating", "SDMA0 is halted, leaving it alone");
+        this->features &= ~kCGSdmaAll;
+    }
+    applySdma(regs, this->features);
+    // MMHUB has no such state to check, it is up whenever the GPU answers MMIO at all.
+    applyMmhub(regs, this->features);
+
+    nred.setProp32("NRedCGMask", this->features);
+    DBGLOG("ClockGating", "Applied mask 0x%X", this->features);
+}
+
+// The RLC must not touch the CGTT overrides while we are changing them.
+bool ClockGating::enterRLCSafeMode()
+{
+    const auto& nred = NRed::singleton();
+    if ((nred.readReg32(GC_BASE_1 + RLC_CNTL) & RLC_CNTL_RLC_ENABLE_F32) == 0) { return false; }
+
+    nred.writeReg32(GC_BASE_1 + RLC_SAFE_MODE, RLC_SAFE_MODE_CMD | RLC_SAFE_MODE_MESSAGE_ENTER);
+    return PenguinWizardry::waitFor(
+               [&nred] { return (nred.readReg32(GC_BASE_1 + RLC_SAFE_MODE) & RLC_SAFE_MODE_CMD) == 0; },
+               RLC_SAFE_MODE_TIMEOUT_MS)
+        .satisfied;
+}
+
+void ClockGating::exitRLCSafeMode() { NRed::singleton().writeReg32(GC_BASE_1 + RLC_SAFE_MODE, RLC_SAFE_MODE_CMD); }
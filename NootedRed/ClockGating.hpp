@@ -0,0 +1,57 @@
+// Clock Gating
+// Medium- and coarse-grain clock gating and memory light sleep for GC, SDMA and MMHUB.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOTypes.h>
+
+enum ClockGatingFeature : UInt32
+{
+    kCGGfxMGCG   = 1U << 0,
+    kCGGfxRlcLS  = 1U << 1,
+    kCGGfxCpLS   = 1U << 2,
+    kCGGfxCGCG   = 1U << 3,
+    kCGGfxCGLS   = 1U << 4,
+    kCGSdmaMGCG  = 1U << 5,
+    kCGSdmaLS    = 1U << 6,
+    kCGMmhubMGCG = 1U << 7,
+    kCGMmhubLS   = 1U << 8,
+
+    kCGGfxAll   = kCGGfxMGCG | kCGGfxRlcLS | kCGGfxCpLS | kCGGfxCGCG | kCGGfxCGLS,
+    kCGSdmaAll  = kCGSdmaMGCG | kCGSdmaLS,
+    kCGMmhubAll = kCGMmhubMGCG | kCGMmhubLS,
+    kCGAll      = kCGGfxAll | kCGSdmaAll | kCGMmhubAll,
+
+    // RLC memory light sleep hangs everything but the original Raven (GC 9.1.0).
+    kCGRaven   = kCGAll,
+    kCGPicasso = kCGAll & ~kCGGfxRlcLS,
+    kCGRaven2  = kCGAll & ~kCGGfxRlcLS,
+    kCGRenoir  = kCGAll & ~kCGGfxRlcLS,
+};
+
+class ClockGating
+{
+    bool   enabled{false};
+    bool   applied{false};    // Set once CAIL has brought every block up.
+    UInt32 mask{0};           // What was asked for.
+    UInt32 features{0};       // What ended up enabled, for the IORegistry.
+
+public:
+    static ClockGating& singleton();
+
+    // Opt-in through `-NRedCG`, everything below is a no-op otherwise.
+    // The per-chip mask can be replaced with `NRedCGMask=<mask>`.
+    void init();
+    // Has to run once every block is initialised, CAIL undoes anything done before that.
+    void apply();
+    // CAIL's SDMA and GC init put their defaults back, e.g. on resume, so the mask is applied again after it.
+    // Does nothing until `apply` has run.
+    void reapply();
+
+private:
+    void        program();
+    static bool enterRLCSafeMode();
+    static void exitRLCSafeMode();
+};
@@ -0,0 +1,94 @@
+// Workload-aware DPM Boost
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <DPMBoost.hpp>
+#include <GPUDriversAMD/RenoirPPSMC.hpp>
+#include <Headers/kern_util.hpp>
+#include <PenguinWizardry/Uptime.hpp>
+#include <SMUQueue.hpp>
+
+static DPMBoost moduleInstance;
+
+DPMBoost& DPMBoost::singleton() { return moduleInstance; }
+
+void DPMBoost::init()
+{
+    if (this->sampler.isEnabled() || !checkKernelArgument("-NRedDPMBoost")) { return; }
+
+    this->sampler.init("DPMBoost", this, &DPMBoost::sampleLocked, SAMPLE_INTERVAL_MS);
+    SYSLOG("DPMBoost", "Enabled");
+}
+
+// The SMU comes back up with the default profile, so the policy starts over as well.
+void DPMBoost::start(void* const ctx)
+{
+    if (!this->sampler.isEnabled()) { return; }
+
+    // The minimum doesn't change at runtime, so it is only read on the first power-up. Posted, as this runs in the
+    // middle of the power-up and the first hints can go without a floor.
+    if (__atomic_load_n(&this->floorGfxClkMHz, __ATOMIC_RELAXED) == 0) {
+        SMUQueue::singleton().post(ctx, PPSMC_MSG_GetMinGfxclkFrequency, 0, HINT_TIMEOUT_MS, floorRead, this);
+    }
+
+    this->sampler.start([this, ctx] {
+        this->ctx = ctx;
+        this->policy.reset();
+        this->lastSampleNs = PenguinWizardry::uptimeNs();
+        __atomic_store_n(&this->submissions, 0, __ATOMIC_RELAXED);
+        return true;
+    });
+}
+
+void DPMBoost::floorRead(void* const context, UInt32, const CAILResult result, const UInt32 outParam)
+{
+    auto* const self = static_cast<DPMBoost*>(context);
+    if (result != kCAILResultOK || outParam == 0) {
+        SYSLOG("DPMBoost", "Failed to read the minimum GFXCLK, not raising it");
+        return;
+    }
+    __atomic_store_n(&self->floorGfxClkMHz, outParam, __ATOMIC_RELAXED);
+}
+
+void DPMBoost::stop()
+{
+    if (!this->sampler.isEnabled()) { return; }
+
+    this->sampler.stop([this] { this->ctx = nullptr; });
+}
+
+void DPMBoost::fullscreenEvent(const bool increase)
+{
+    if (!this->sampler.isEnabled()) { return; }
+
+    IOLockLock(this->sampler.getLock());
+    this->fullscreenCount = increase ? this->fullscreenCount + 1 : 0;
+    IOLockUnlock(this->sampler.getLock());
+}
+
+bool DPMBoost::sampleLocked()
+{
+    const auto now    = PenguinWizardry::uptimeNs();
+    const auto sample = DPMSample{
+        .elapsedMs   = static_cast<UInt32>((now - this->lastSampleNs) / 1000000),
+        .submissions = __atomic_exchange_n(&this->submissions, 0, __ATOMIC_RELAXED),
+        .refreshHz   = __atomic_load_n(&this->refreshHz, __ATOMIC_RELAXED),
+        .fullscreen  = this->fullscreenCount != 0,
+    };
+    this->lastSampleNs = now;
+
+    if (this->policy.step(sample)) {
+        const auto hint = this->policy.getHint();
+        DBGLOG("DPMBoost", "Level %d at %u submissions/s, workload 0x%X, min GFXCLK %uMHz",
+               static_cast<int>(hint.level), this->policy.getRate(), hint.workloadMask, hint.minGfxClkMHz);
+        SMUQueue::singleton().post(this->ctx, PPSMC_MSG_ActiveProcessNotify, hint.workloadMask, HINT_TIMEOUT_MS);
+        // Without the real minimum there is nothing to go back to, 0 is not a valid clock.
+        const auto floorGfxClkMHz = __atomic_load_n(&this->floorGfxClkMHz, __ATOMIC_RELAXED);
+        if (floorGfxClkMHz != 0) {
+            const auto minGfxClkMHz = hint.minGfxClkMHz == 0 ? floorGfxClkMHz : hint.minGfxClkMHz;
+            SMUQueue::singleton().post(this->ctx, PPSMC_MSG_SetHardMinGfxClk, minGfxClkMHz, HINT_TIMEOUT_MS);
+        }
+    }
+    return true;
+}
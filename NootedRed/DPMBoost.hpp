@@ -0,0 +1,45 @@
+// Workload-aware DPM Boost
+// Samples the submission rate, fullscreen state and refresh rate, and forwards `DPMPolicy` hints to the SMU.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <DPMPolicy.hpp>
+#include <GPUDriversAMD/CAIL/Result.hpp>
+#include <IOKit/IOTypes.h>
+#include <PenguinWizardry/PeriodicCall.hpp>
+
+class DPMBoost
+{
+    static constexpr UInt32 SAMPLE_INTERVAL_MS = 100;
+    static constexpr UInt32 HINT_TIMEOUT_MS    = 500;
+
+    PenguinWizardry::PeriodicCall<DPMBoost> sampler{};
+    DPMPolicy                               policy{};
+    void*                                   ctx{nullptr};    // Non-null while the SMU is up.
+    UInt64                                  lastSampleNs{0};
+    UInt32                                  submissions{0};
+    UInt32                                  refreshHz{0};
+    UInt32                                  fullscreenCount{0};
+    UInt32                                  floorGfxClkMHz{0};    // The SMU's own minimum, 0 until it has been read.
+
+public:
+    static DPMBoost& singleton();
+
+    // Opt-in through `-NRedDPMBoost`, everything below is a no-op otherwise.
+    void init();
+    void start(void* ctx);
+    void stop();
+
+    void noteSubmission()
+    {
+        if (this->sampler.isEnabled()) { __atomic_fetch_add(&this->submissions, 1, __ATOMIC_RELAXED); }
+    }
+    void setRefreshRate(const UInt32 hz) { __atomic_store_n(&this->refreshHz, hz, __ATOMIC_RELAXED); }
+    void fullscreenEvent(bool increase);
+
+private:
+    bool        sampleLocked();
+    static void floorRead(void* context, UInt32 message, CAILResult result, UInt32 outParam);
+};
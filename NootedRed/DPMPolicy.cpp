@@ -0,0 +1,68 @@
+// Workload-aware DPM Boost Policy
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <DPMPolicy.hpp>
+
+// Feeds a recorded trace through a fresh policy and checks the level after every sample.
+template<size_t N>
+static constexpr bool replay(const DPMSample (&trace)[N], const DPMLevel (&expected)[N])
+{
+    DPMPolicy policy{};
+    for (size_t i = 0; i < N; i += 1) {
+        policy.step(trace[i]);
+        if (policy.getLevel() != expected[i]) { return false; }
+    }
+    return true;
+}
+
+static constexpr auto I = DPMLevel::Idle;
+static constexpr auto M = DPMLevel::Balanced;
+static constexpr auto B = DPMLevel::Boost;
+
+// 200 submissions/s, windowed. The smoothing takes four samples to cross the boost threshold.
+static constexpr DPMSample kRender[] = {
+    {100, 20, 0, false}, {100, 20, 0, false}, {100, 20, 0, false}, {100, 20, 0, false},
+    {100, 20, 0, false}, {100, 20, 0, false}, {100, 20, 0, false}, {100, 20, 0, false},
+};
+static_assert(replay(kRender, {M, M, M, B, B, B, B, B}));
+
+// A single burst doesn't boost, and idle only comes after the rate has stayed low for a second.
+static constexpr DPMSample kBurstThenQuiet[] = {
+    {100, 13, 0, false}, {500, 0, 0, false}, {500, 0, 0, false}, {500, 0, 0, false},
+    {500, 0, 0, false},  {500, 0, 0, false}, {500, 0, 0, false}, {500, 0, 0, false},
+    {500, 0, 0, false},  {500, 0, 0, false}, {500, 0, 0, false}, {500, 0, 0, false},
+};
+static_assert(replay(kBurstThenQuiet, {M, M, M, M, M, M, M, M, M, M, I, I}));
+
+// Boost is left at half the entry rate, and only after two seconds below it.
+static constexpr DPMSample kRenderThenStop[] = {
+    {100, 20, 0, false}, {100, 20, 0, false}, {100, 20, 0, false}, {100, 20, 0, false},
+    {100, 20, 0, false}, {100, 20, 0, false}, {500, 0, 0, false},  {500, 0, 0, false},
+    {500, 0, 0, false},  {500, 0, 0, false},  {500, 0, 0, false},  {500, 0, 0, false},
+    {500, 0, 0, false},  {500, 0, 0, false},
+};
+static_assert(replay(kRenderThenStop, {M, M, M, B, B, B, B, B, B, B, B, B, M, M}));
+
+// A fullscreen 60Hz game only needs 30 submissions/s to boost, the same load windowed doesn't.
+static constexpr DPMSample kFullscreen60Hz[] = {
+    {100, 5, 60, true}, {100, 5, 60, true}, {100, 5, 60, true},
+    {100, 5, 60, true}, {100, 5, 60, true}, {100, 5, 60, true},
+};
+static constexpr DPMSample kWindowed60Hz[] = {
+    {100, 5, 60, false}, {100, 5, 60, false}, {100, 5, 60, false},
+    {100, 5, 60, false}, {100, 5, 60, false}, {100, 5, 60, false},
+};
+static_assert(replay(kFullscreen60Hz, {M, M, M, B, B, B}));
+static_assert(replay(kWindowed60Hz, {M, M, M, M, M, M}));
+
+// Something fullscreen never idles, however quiet it is.
+static constexpr DPMSample kFullscreenStill[] = {
+    {500, 0, 60, true}, {500, 0, 60, true}, {500, 0, 60, true}, {500, 0, 60, true},
+};
+static_assert(replay(kFullscreenStill, {M, M, M, M}));
+
+// Back-to-back samples carry no time and are dropped instead of dividing by zero.
+static constexpr DPMSample kNoTimePassed[] = {{0, 100, 0, false}, {0, 100, 0, false}, {100, 0, 0, false}};
+static_assert(replay(kNoTimePassed, {M, M, M}));
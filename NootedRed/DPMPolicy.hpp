@@ -0,0 +1,137 @@
+// Workload-aware DPM Boost Policy
+// Pure state machine, no kernel state is touched here so recorded workload traces can be replayed as-is.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOTypes.h>
+
+// Bit indices for `PPSMC_MSG_ActiveProcessNotify`, shared by SMU 10 and 12.
+enum DPMWorkload : UInt32
+{
+    kDPMWorkloadDefault      = 0,
+    kDPMWorkloadFullScreen3D = 1,
+    kDPMWorkloadPowerSaving  = 2,
+};
+
+enum struct DPMLevel : UInt8
+{
+    Idle,
+    Balanced,
+    Boost,
+};
+
+struct DPMSample
+{
+    UInt32 elapsedMs;      // Since the previous sample.
+    UInt32 submissions;    // Command buffers submitted since the previous sample.
+    UInt32 refreshHz;      // 0 if unknown.
+    bool   fullscreen;
+};
+
+struct DPMHint
+{
+    DPMLevel level;
+    UInt32   workloadMask;    // `PPSMC_MSG_ActiveProcessNotify` parameter.
+    UInt32   minGfxClkMHz;    // `PPSMC_MSG_SetHardMinGfxClk` parameter, 0 for the SMU's own minimum.
+};
+
+// Going up is immediate, going down has to be wanted for a while first,
+// and every threshold has a separate exit point, so bursty render loops don't flap between levels.
+class DPMPolicy
+{
+public:
+    struct Tunables
+    {
+        UInt32 boostEnterRate{120};    // Submissions per second, lowered to half the refresh rate in fullscreen.
+        UInt32 idleEnterRate{2};
+        UInt32 idleExitRate{10};
+        UInt32 boostExitDwellMs{2000};
+        UInt32 idleEnterDwellMs{1000};
+        UInt32 boostMinGfxClkMHz{800};
+    };
+
+private:
+    Tunables tunables;
+    DPMLevel level{DPMLevel::Balanced};
+    DPMLevel pendingLevel{DPMLevel::Balanced};
+    UInt32   pendingMs{0};
+    UInt32   rate{0};    // Smoothed, in submissions per second.
+
+public:
+    constexpr DPMPolicy() = default;
+    explicit constexpr DPMPolicy(const Tunables& tunables) : tunables{tunables} {}
+
+    // Returns whether the hint changed.
+    constexpr bool step(const DPMSample& sample)
+    {
+        if (sample.elapsedMs == 0) { return false; }
+
+        // EWMA with a weight of 1/4, a single burst shouldn't be enough to boost.
+        const auto sampleRate = static_cast<UInt64>(sample.submissions) * 1000 / sample.elapsedMs;
+        this->rate            = static_cast<UInt32>((static_cast<UInt64>(this->rate) * 3 + sampleRate) / 4);
+
+        const auto target = this->targetFor(sample);
+        if (target == this->level) {
+            this->pendingMs = 0;
+            return false;
+        }
+
+        if (target < this->level) {
+            if (target != this->pendingLevel) {
+                this->pendingLevel = target;
+                this->pendingMs    = 0;
+            }
+            this->pendingMs += sample.elapsedMs;
+            const auto dwellMs =
+                this->level == DPMLevel::Boost ? this->tunables.boostExitDwellMs : this->tunables.idleEnterDwellMs;
+            if (this->pendingMs < dwellMs) { return false; }
+        }
+
+        this->level        = target;
+        this->pendingLevel = target;
+        this->pendingMs    = 0;
+        return true;
+    }
+
+    constexpr void reset()
+    {
+        this->level        = DPMLevel::Balanced;
+        this->pendingLevel = DPMLevel::Balanced;
+        this->pendingMs    = 0;
+        this->rate         = 0;
+    }
+
+    constexpr DPMLevel getLevel() const { return this->level; }
+    constexpr UInt32   getRate() const { return this->rate; }
+
+    constexpr DPMHint getHint() const
+    {
+        const auto boostMHz = this->tunables.boostMinGfxClkMHz;
+        switch (this->level) {
+            case DPMLevel::Idle : return {this->level, 1U << kDPMWorkloadPowerSaving, 0};
+            case DPMLevel::Boost: return {this->level, 1U << kDPMWorkloadFullScreen3D, boostMHz};
+            default             : return {this->level, 1U << kDPMWorkloadDefault, 0};
+        }
+    }
+
+private:
+    constexpr DPMLevel targetFor(const DPMSample& sample) const
+    {
+        auto boostEnterRate = this->tunables.boostEnterRate;
+        if (sample.fullscreen && sample.refreshHz / 2 != 0 && sample.refreshHz / 2 < boostEnterRate) {
+            boostEnterRate = sample.refreshHz / 2;
+        }
+        if (this->rate >= (this->level == DPMLevel::Boost ? boostEnterRate / 2 : boostEnterRate)) {
+            return DPMLevel::Boost;
+        }
+
+        // Something is on screen, never drop below balanced.
+        if (sample.fullscreen) { return DPMLevel::Balanced; }
+
+        const auto idleRate =
+            this->level == DPMLevel::Idle ? this->tunables.idleExitRate : this->tunables.idleEnterRate;
+        return this->rate < idleRate ? DPMLevel::Idle : DPMLevel::Balanced;
+    }
+};
@@ -0,0 +1,78 @@
+// GC Topology
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <GCTopology.hpp>
+#include <GPUDriversAMD/RavenIPOffset.hpp>
+#include <GfxOff.hpp>
+#include <Headers/kern_util.hpp>
+#include <NRed.hpp>
+#include <PenguinWizardry/Stats.hpp>
+#include <libkern/c++/OSDictionary.h>
+
+static constexpr GCShaderArrayConfig kAllActive[GCTopology::MAX_SE][GCTopology::MAX_SH_PER_SE] = {};
+static constexpr GCShaderArrayConfig kHarvested[GCTopology::MAX_SE][GCTopology::MAX_SH_PER_SE] = {
+    {{.fused = 0x00070000, .user = 0x00000000}, {}},
+};
+static constexpr GCShaderArrayConfig kUserDisabled[GCTopology::MAX_SE][GCTopology::MAX_SH_PER_SE] = {
+    {{.fused = 0x00030000, .user = 0x00060000}, {}},
+};
+static constexpr GCShaderArrayConfig kAllFused[GCTopology::MAX_SE][GCTopology::MAX_SH_PER_SE] = {
+    {{.fused = 0xFFFF0000, .user = 0x00000000}, {}},
+};
+
+static_assert(GCTopology::decode(kAllActive, 1, 1, 11).cuCount == 11);
+static_assert(GCTopology::decode(kAllActive, 1, 1, 11).activeCUs[0][0] == 0x7FF);
+static_assert(GCTopology::decode(kHarvested, 1, 1, 11).cuCount == 8);
+static_assert(GCTopology::decode(kHarvested, 1, 1, 11).activeCUs[0][0] == 0x7F8);
+static_assert(GCTopology::decode(kUserDisabled, 1, 1, 8).cuCount == 5);
+static_assert(GCTopology::decode(kAllFused, 1, 1, 3).seCount == 0);
+static_assert(GCTopology::decode(kAllActive, 1, 1, 3).seCount == 1);
+static_assert(GCTopology::decode(kAllActive, 1, 1, 3).shPerSE == 1);
+
+GCTopology GCTopology::read(const UInt32 maxSEs, const UInt32 maxSHsPerSE, const UInt32 maxCUsPerSH)
+{
+    const auto&         nred = NRed::singleton();
+    const GfxOffGuard   gfxOffGuard;
+    GCShaderArrayConfig configs[MAX_SE][MAX_SH_PER_SE] = {};
+    for (UInt32 se = 0; se < maxSEs && se < MAX_SE; se += 1) {
+        for (UInt32 sh = 0; sh < maxSHsPerSE && sh < MAX_SH_PER_SE; sh += 1) {
+            const UInt32 index = (se << GRBM_GFX_INDEX_SE_INDEX_SHIFT) | (sh << GRBM_GFX_INDEX_SH_INDEX_SHIFT)
+                                 | GRBM_GFX_INDEX_INSTANCE_BROADCAST_WRITES;
+            nred.writeReg32(GC_BASE_1 + GRBM_GFX_INDEX, index);
+            configs[se][sh] = {
+                .fused = nred.readReg32(GC_BASE_1 + CC_GC_SHADER_ARRAY_CONFIG),
+                .user  = nred.readReg32(GC_BASE_1 + GC_USER_SHADER_ARRAY_CONFIG),
+            };
+        }
+    }
+    constexpr UInt32 broadcast = GRBM_GFX_INDEX_SE_BROADCAST_WRITES | GRBM_GFX_INDEX_SH_BROADCAST_WRITES
+                                 | GRBM_GFX_INDEX_INSTANCE_BROADCAST_WRITES;
+    nred.writeReg32(GC_BASE_1 + GRBM_GFX_INDEX, broadcast);
+
+    auto ret        = decode(configs, maxSEs, maxSHsPerSE, maxCUsPerSH);
+    ret.alwaysOnCUs = nred.readReg32(GC_BASE_1 + RLC_LB_ALWAYS_ACTIVE_CU_MASK);
+    return ret;
+}
+
+void GCTopology::publish() const
+{
+    auto* const dict = OSDictionary::withCapacity(4 + MAX_SE * MAX_SH_PER_SE);
+    if (dict == nullptr) { return; }
+
+    PenguinWizardry::setStatsNumber(dict, "SEs", this->seCount);
+    PenguinWizardry::setStatsNumber(dict, "SHsPerSE", this->shPerSE);
+    PenguinWizardry::setStatsNumber(dict, "CUs", this->cuCount);
+    PenguinWizardry::setStatsNumber(dict, "AlwaysOnCUMask", this->alwaysOnCUs);
+    char key[16];
+    for (UInt32 se = 0; se < MAX_SE; se += 1) {
+        for (UInt32 sh = 0; sh < MAX_SH_PER_SE; sh += 1) {
+            if (this->activeCUs[se][sh] == 0) { continue; }
+            snprintf(key, arrsize(key), "SE%uSH%u", se, sh);
+            PenguinWizardry::setStatsNumber(dict, key, this->activeCUs[se][sh]);
+        }
+    }
+    NRed::singleton().setProp("NRedGCTopology", dict);
+    dict->release();
+}
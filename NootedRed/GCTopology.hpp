@@ -0,0 +1,58 @@
+// GC Topology
+// Decodes which CUs survived harvesting from the shader array configuration, for diagnostics.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOTypes.h>
+#include <Regs/GC.hpp>
+
+struct GCShaderArrayConfig
+{
+    UInt32 fused;    // CC_GC_SHADER_ARRAY_CONFIG
+    UInt32 user;     // GC_USER_SHADER_ARRAY_CONFIG
+};
+
+struct GCTopology
+{
+    static constexpr UInt32 MAX_SE        = 4;
+    static constexpr UInt32 MAX_SH_PER_SE = 2;
+
+    UInt32 seCount{0};
+    UInt32 shPerSE{0};
+    UInt32 cuCount{0};
+    UInt32 activeCUs[MAX_SE][MAX_SH_PER_SE]{};
+    UInt32 alwaysOnCUs{0};    // RLC_LB_ALWAYS_ACTIVE_CU_MASK, not part of decoding.
+
+    static constexpr UInt32 activeCUBitmap(const GCShaderArrayConfig& config, const UInt32 maxCUsPerSH)
+    {
+        const UInt32 inactive = ((config.fused | config.user) & CC_GC_SHADER_ARRAY_CONFIG_INACTIVE_CUS_MASK)
+                                >> CC_GC_SHADER_ARRAY_CONFIG_INACTIVE_CUS_SHIFT;
+        return ~inactive & ((1U << maxCUsPerSH) - 1);
+    }
+
+    // An SE counts if any of its SHs has a CU left, `shPerSE` is the most SHs left in any SE.
+    static constexpr GCTopology decode(const GCShaderArrayConfig (&configs)[MAX_SE][MAX_SH_PER_SE],
+                                       const UInt32 maxSEs, const UInt32 maxSHsPerSE, const UInt32 maxCUsPerSH)
+    {
+        GCTopology ret{};
+        for (UInt32 se = 0; se < maxSEs && se < MAX_SE; se += 1) {
+            UInt32 shCount = 0;
+            for (UInt32 sh = 0; sh < maxSHsPerSE && sh < MAX_SH_PER_SE; sh += 1) {
+                const auto bitmap     = activeCUBitmap(configs[se][sh], maxCUsPerSH);
+                ret.activeCUs[se][sh] = bitmap;
+                ret.cuCount += static_cast<UInt32>(__builtin_popcount(bitmap));
+                if (bitmap != 0) { shCount += 1; }
+            }
+            if (shCount != 0) { ret.seCount += 1; }
+            if (shCount > ret.shPerSE) { ret.shPerSE = shCount; }
+        }
+        return ret;
+    }
+
+    // Walks every SE/SH through `GRBM_GFX_INDEX`, GC has to be up.
+    static GCTopology read(UInt32 maxSEs, UInt32 maxSHsPerSE, UInt32 maxCUsPerSH);
+
+    void publish() const;
+};
@@ -9,10 +9,10 @@
 
 struct CAILGoldenRegister
 {
-    const UInt32 regOffset;
-    const UInt32 segment;
-    const UInt32 andMask;
-    const UInt32 orMask;
+    UInt32 regOffset;
+    UInt32 segment;
+    UInt32 andMask;
+    UInt32 orMask;
 };
 
 #define GOLDEN_REGISTER(reg, and, or) {.regOffset = (reg), .segment = reg##_BASE_IDX, .andMask = and, .orMask = or }
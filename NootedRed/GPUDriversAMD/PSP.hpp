@@ -4,6 +4,7 @@
 // See LICENSE for details.
 
 #pragma once
+#include <IOKit/IOTypes.h>
 
 enum AMDPSPCommand
 {
@@ -12,6 +13,19 @@ enum AMDPSPCommand
     kPSPCommandLoadIPFW = 6,
 };
 
+// `TEE_ERROR_NOT_SUPPORTED`, what the PSP answers for a TA it can't load.
+static constexpr UInt32 kPSPStatusNotSupported = 0xFFFF000A;
+
+// The head of `psp_gfx_resp`, which CAIL reads back after every submission.
+struct AMDPSPResponse
+{
+    UInt32 status;
+    UInt32 sessionID;
+    UInt32 fwAddrLo;
+    UInt32 fwAddrHi;
+    UInt32 tmrSize;
+};
+
 enum AMDPSPFirmwareID
 {
     kPSPFirmwareUnknown,
@@ -68,3 +82,53 @@ enum AMDPSPFirmwareID
     kPSPFirmwareRS64KIQ,
     kPSPFirmwareRS64KIQStack,
 };
+
+// Images signed for the PSP are laid out as a 0x100 byte header, the payload and a 0x100 byte signature.
+static constexpr size_t kPSPFirmwareHeaderSize         = 0x100;
+static constexpr size_t kPSPFirmwareSignatureSize      = 0x100;
+static constexpr size_t kPSPFirmwareHeaderBodySizeOff  = 0x14;
+static constexpr size_t kPSPFirmwareHeaderVersionOff   = 0x60;
+static constexpr size_t kPSPFirmwareHeaderImageSizeOff = 0x6C;
+
+template<const size_t N>
+constexpr UInt32 pspFirmwareHeaderRead32(const char (&data)[N], const size_t off)
+{
+    static_assert(N >= kPSPFirmwareHeaderSize, "Firmware image is smaller than its header");
+    return static_cast<UInt32>(static_cast<UInt8>(data[off]))
+           | (static_cast<UInt32>(static_cast<UInt8>(data[off + 1])) << 8)
+           | (static_cast<UInt32>(static_cast<UInt8>(data[off + 2])) << 16)
+           | (static_cast<UInt32>(static_cast<UInt8>(data[off + 3])) << 24);
+}
+
+template<const size_t N>
+constexpr bool pspFirmwareIsValid(const char (&data)[N])
+{
+    return pspFirmwareHeaderRead32(data, kPSPFirmwareHeaderImageSizeOff) == N
+           && kPSPFirmwareHeaderSize + pspFirmwareHeaderRead32(data, kPSPFirmwareHeaderBodySizeOff)
+                      + kPSPFirmwareSignatureSize
+                  == N;
+}
+
+template<const size_t N>
+constexpr UInt32 pspFirmwareVersion(const char (&data)[N])
+{ return pspFirmwareHeaderRead32(data, kPSPFirmwareHeaderVersionOff); }
+
+// CAIL wants the firmware version as a string, e.g. `#480` for GC and `40` for SDMA.
+struct PSPFirmwareVersionString
+{
+    char value[12]{};
+
+    constexpr PSPFirmwareVersionString(UInt32 version, const char prefix)
+    {
+        char   digits[10]{};
+        size_t count = 0;
+        do {
+            digits[count++]  = static_cast<char>('0' + (version % 10));
+            version         /= 10;
+        } while (version != 0);
+
+        size_t i = 0;
+        if (prefix != '\0') { this->value[i++] = prefix; }
+        while (count != 0) { this->value[i++] = digits[--count]; }
+    }
+};
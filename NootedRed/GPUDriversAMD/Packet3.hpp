@@ -6,18 +6,320 @@
 #pragma once
 #include <Headers/kern_util.hpp>
 
-static UInt32 packet3Header(const UInt8 op, const UInt16 payloadDWords)
+// `payloadDWords` is the number of dwords after the header minus one, as the CP expects it.
+constexpr UInt32 packet3Header(const UInt8 op, const UInt16 payloadDWords)
 { return (3U << 30) | ((static_cast<UInt32>(op) & 0xFF) << 8) | ((static_cast<UInt32>(payloadDWords) & 0x3FFF) << 16); }
 
-constexpr UInt32 PACKET3_WRITE_DATA             = 0x37;
-constexpr UInt32 PACKET3_WRITE_DATA_WR_ONE_ADDR = getBit(16);
+constexpr UInt32 PACKET3_MAX_PAYLOAD_DWORDS = 0x4000;
+
+constexpr UInt8 PACKET3_WRITE_DATA      = 0x37;
+constexpr UInt8 PACKET3_WAIT_REG_MEM    = 0x3C;
+constexpr UInt8 PACKET3_INDIRECT_BUFFER = 0x3F;
+constexpr UInt8 PACKET3_RELEASE_MEM     = 0x49;
+constexpr UInt8 PACKET3_SET_CONFIG_REG  = 0x68;
+constexpr UInt8 PACKET3_SET_CONTEXT_REG = 0x69;
+constexpr UInt8 PACKET3_SET_SH_REG      = 0x76;
+constexpr UInt8 PACKET3_SET_UCONFIG_REG = 0x79;
+
+constexpr UInt32 PACKET3_WRITE_DATA_DST_SEL_REG     = 0 << 8;
+constexpr UInt32 PACKET3_WRITE_DATA_DST_SEL_MEM     = 5 << 8;
+constexpr UInt32 PACKET3_WRITE_DATA_WR_ONE_ADDR     = getBit(16);
+constexpr UInt32 PACKET3_WRITE_DATA_WR_CONFIRM      = getBit(20);
+constexpr UInt32 PACKET3_WAIT_REG_MEM_FUNC_EQUAL    = 3;
+constexpr UInt32 PACKET3_WAIT_REG_MEM_SPACE_MEM     = getBit(4);
+constexpr UInt32 PACKET3_RELEASE_MEM_EVENT_INDEX    = 5 << 8;
+constexpr UInt32 PACKET3_RELEASE_MEM_TC_WB_ACTION   = getBit(15);
+constexpr UInt32 PACKET3_RELEASE_MEM_TCL1_ACTION    = getBit(16);
+constexpr UInt32 PACKET3_RELEASE_MEM_TC_ACTION      = getBit(17);
+constexpr UInt32 PACKET3_RELEASE_MEM_TC_NC_ACTION   = getBit(19);
+constexpr UInt32 PACKET3_RELEASE_MEM_TC_MD_ACTION   = getBit(21);
+constexpr UInt32 PACKET3_RELEASE_MEM_DATA_SEL_32    = 1U << 29;
+constexpr UInt32 PACKET3_RELEASE_MEM_DATA_SEL_64    = 2U << 29;
+constexpr UInt32 PACKET3_RELEASE_MEM_DATA_SEL_TS    = 3U << 29;
+constexpr UInt32 PACKET3_RELEASE_MEM_INT_SEL_WRITE  = 2U << 24;
+constexpr UInt32 PACKET3_INDIRECT_BUFFER_VALID      = getBit(23);
+constexpr UInt32 PACKET3_INDIRECT_BUFFER_VMID_SHIFT = 24;
+
+// The cache actions of a regular fence, and of one that only has to write back what's pending in TC.
+constexpr UInt32 PACKET3_RELEASE_MEM_CACHE_FLUSH   = PACKET3_RELEASE_MEM_TCL1_ACTION | PACKET3_RELEASE_MEM_TC_ACTION
+                                                     | PACKET3_RELEASE_MEM_TC_WB_ACTION
+                                                     | PACKET3_RELEASE_MEM_TC_MD_ACTION;
+constexpr UInt32 PACKET3_RELEASE_MEM_CACHE_WB_ONLY = PACKET3_RELEASE_MEM_TC_WB_ACTION
+                                                     | PACKET3_RELEASE_MEM_TC_NC_ACTION;
+
+constexpr UInt32 CACHE_FLUSH_AND_INV_TS_EVENT = 0x14;
+constexpr UInt32 BOTTOM_OF_PIPE_TS            = 0x28;
+
+// Absolute dword offsets, the packets only carry the offset from the start of the range.
+enum struct PM4RegSpace : UInt8
+{
+    Config,
+    Context,
+    SH,
+    UConfig,
+};
+
+constexpr UInt32 pm4RegSpaceStart(const PM4RegSpace space)
+{
+    switch (space) {
+        case PM4RegSpace::Config : return 0x2000;
+        case PM4RegSpace::Context: return 0xA000;
+        case PM4RegSpace::SH     : return 0x2C00;
+        case PM4RegSpace::UConfig: return 0xC000;
+    }
+    return 0;
+}
+
+constexpr UInt32 pm4RegSpaceEnd(const PM4RegSpace space)
+{
+    switch (space) {
+        case PM4RegSpace::Config : return 0x2C00;
+        case PM4RegSpace::Context: return 0xA400;
+        case PM4RegSpace::SH     : return 0x3000;
+        case PM4RegSpace::UConfig: return 0x10000;
+    }
+    return 0;
+}
+
+constexpr UInt8 pm4RegSpaceOp(const PM4RegSpace space)
+{
+    switch (space) {
+        case PM4RegSpace::Config : return PACKET3_SET_CONFIG_REG;
+        case PM4RegSpace::Context: return PACKET3_SET_CONTEXT_REG;
+        case PM4RegSpace::SH     : return PACKET3_SET_SH_REG;
+        case PM4RegSpace::UConfig: return PACKET3_SET_UCONFIG_REG;
+    }
+    return 0;
+}
+
+constexpr bool isInPM4RegSpace(const PM4RegSpace space, const UInt32 reg)
+{ return reg >= pm4RegSpaceStart(space) && reg < pm4RegSpaceEnd(space); }
+
+// Appends GFX9 PM4 packets to a caller-owned buffer. Running out of space or passing a register outside its space
+// doesn't write anything further and marks the stream invalid, so check `isValid` before submitting.
+// Consecutive `setReg` calls on consecutive registers of the same space share one SET_*_REG packet.
+class PM4Builder
+{
+    UInt32* buffer;
+    size_t  capacity;
+    size_t  size{0};
+    bool    valid{true};
+    size_t  setRegHeader{0};    // The rest is only meaningful while `setRegNext` is non-zero.
+    size_t  setRegPayload{0};
+    UInt32  setRegNext{0};
+    UInt8   setRegOp{0};
+
+    constexpr bool reserve(const size_t dwords)
+    {
+        if (!this->valid || this->capacity - this->size < dwords) {
+            this->valid = false;
+            return false;
+        }
+        return true;
+    }
+
+    constexpr void emit(const UInt32 dword) { this->buffer[this->size++] = dword; }
+
+    constexpr bool beginPacket(const UInt8 op, const size_t payloadDWords)
+    {
+        this->setRegNext = 0;
+        if (payloadDWords == 0 || payloadDWords > PACKET3_MAX_PAYLOAD_DWORDS) {
+            this->valid = false;
+            return false;
+        }
+        if (!this->reserve(payloadDWords + 1)) { return false; }
+        this->emit(packet3Header(op, static_cast<UInt16>(payloadDWords - 1)));
+        return true;
+    }
+
+public:
+    constexpr PM4Builder(UInt32* const buffer, const size_t capacity) : buffer{buffer}, capacity{capacity} {}
+
+    constexpr size_t getSize() const { return this->size; }
+    constexpr bool   isValid() const { return this->valid; }
+
+    constexpr void setReg(const PM4RegSpace space, const UInt32 reg, const UInt32 value)
+    {
+        if (!isInPM4RegSpace(space, reg)) {
+            this->valid = false;
+            return;
+        }
+        const auto op = pm4RegSpaceOp(space);
+        if (this->setRegNext == reg && this->setRegOp == op && this->setRegPayload < PACKET3_MAX_PAYLOAD_DWORDS) {
+            if (!this->reserve(1)) { return; }
+            this->setRegPayload += 1;
+            this->buffer[this->setRegHeader] = packet3Header(op, static_cast<UInt16>(this->setRegPayload - 1));
+            this->emit(value);
+            this->setRegNext += 1;
+            return;
+        }
+        const auto header = this->size;
+        if (!this->beginPacket(op, 2)) { return; }
+        this->emit(reg - pm4RegSpaceStart(space));
+        this->emit(value);
+        this->setRegHeader  = header;
+        this->setRegPayload = 2;
+        this->setRegOp      = op;
+        this->setRegNext    = reg + 1;
+    }
+
+    template<PM4RegSpace Space, UInt32 Reg>
+    constexpr void setReg(const UInt32 value)
+    {
+        static_assert(isInPM4RegSpace(Space, Reg), "Register is outside of its SET_*_REG range");
+        this->setReg(Space, Reg, value);
+    }
+
+    constexpr void writeRegister(const UInt32 reg, const UInt32 value)
+    {
+        if (!this->beginPacket(PACKET3_WRITE_DATA, 4)) { return; }
+        this->emit(PACKET3_WRITE_DATA_DST_SEL_REG | PACKET3_WRITE_DATA_WR_ONE_ADDR);
+        this->emit(reg);
+        this->emit(0);
+        this->emit(value);
+    }
+
+    constexpr void writeMemory(const UInt64 addr, const UInt32 value)
+    {
+        if (!this->beginPacket(PACKET3_WRITE_DATA, 4)) { return; }
+        this->emit(PACKET3_WRITE_DATA_DST_SEL_MEM | PACKET3_WRITE_DATA_WR_CONFIRM);
+        this->emit(static_cast<UInt32>(addr) & ~3U);
+        this->emit(static_cast<UInt32>(addr >> 32));
+        this->emit(value);
+    }
+
+    // Stalls the CP until `(*addr & mask) == reference`.
+    constexpr void waitMemoryEqual(const UInt64 addr, const UInt32 reference, const UInt32 mask,
+                                   const UInt32 pollInterval)
+    {
+        if (!this->beginPacket(PACKET3_WAIT_REG_MEM, 6)) { return; }
+        this->emit(PACKET3_WAIT_REG_MEM_FUNC_EQUAL | PACKET3_WAIT_REG_MEM_SPACE_MEM);
+        this->emit(static_cast<UInt32>(addr) & ~3U);
+        this->emit(static_cast<UInt32>(addr >> 32));
+        this->emit(reference);
+        this->emit(mask);
+        this->emit(pollInterval);
+    }
+
+    // `cacheActions` is a mask of `PACKET3_RELEASE_MEM_*_ACTION`, usually `PACKET3_RELEASE_MEM_CACHE_FLUSH`.
+    // `dataSel` is one of `PACKET3_RELEASE_MEM_DATA_SEL_*`, `TS` writes the GPU clock counter instead of `data`.
+    constexpr void releaseMem(const UInt32 event, const UInt32 cacheActions, const UInt64 addr, const UInt32 dataSel,
+                              const UInt64 data, const bool interrupt)
+    {
+        if ((cacheActions & ~(PACKET3_RELEASE_MEM_CACHE_FLUSH | PACKET3_RELEASE_MEM_TC_NC_ACTION)) != 0) {
+            this->valid = false;
+            return;
+        }
+        if (!this->beginPacket(PACKET3_RELEASE_MEM, 7)) { return; }
+        this->emit(event | cacheActions | PACKET3_RELEASE_MEM_EVENT_INDEX);
+        this->emit(dataSel | (interrupt ? PACKET3_RELEASE_MEM_INT_SEL_WRITE : 0));
+        this->emit(static_cast<UInt32>(addr) & ~3U);
+        this->emit(static_cast<UInt32>(addr >> 32));
+        this->emit(static_cast<UInt32>(data));
+        this->emit(static_cast<UInt32>(data >> 32));
+        this->emit(0);
+    }
+
+    // Compute rings take `valid`, the graphics ring doesn't.
+    constexpr void indirectBuffer(const UInt64 addr, const UInt32 sizeDWords, const UInt32 vmid, const bool valid)
+    {
+        if (sizeDWords == 0 || sizeDWords > 0xFFFFF || vmid > 0xF) {
+            this->valid = false;
+            return;
+        }
+        if (!this->beginPacket(PACKET3_INDIRECT_BUFFER, 3)) { return; }
+        this->emit(static_cast<UInt32>(addr) & ~3U);
+        this->emit(static_cast<UInt32>(addr >> 32) & 0xFFFF);
+        const auto control = sizeDWords | (vmid << PACKET3_INDIRECT_BUFFER_VMID_SHIFT);
+        this->emit(valid ? control | PACKET3_INDIRECT_BUFFER_VALID : control);
+    }
+};
 
 inline UInt32 write1RegWritePacket(UInt32* buffer, const UInt32 reg, const UInt32 data)
 {
-    *buffer++ = packet3Header(PACKET3_WRITE_DATA, 3);    // header
-    *buffer++ = PACKET3_WRITE_DATA_WR_ONE_ADDR;          // control
-    *buffer++ = reg;                                     // addrLow
-    *buffer++ = 0;                                       // addrHigh
-    *buffer++ = data;                                    // data
-    return 5;
+    PM4Builder builder{buffer, 5};
+    builder.writeRegister(reg, data);
+    return static_cast<UInt32>(builder.getSize());
 }
+
+namespace PM4BuilderTests
+{
+
+    template<size_t N, typename F>
+    constexpr bool matches(const UInt32 (&expected)[N], const F& build)
+    {
+        UInt32     buffer[N + 1] = {};
+        PM4Builder builder{buffer, N + 1};
+        build(builder);
+        if (!builder.isValid() || builder.getSize() != N) { return false; }
+        for (size_t i = 0; i < N; i += 1) {
+            if (buffer[i] != expected[i]) { return false; }
+        }
+        return true;
+    }
+
+    constexpr UInt32 kWriteRegister[] = {0xC0033700, 0x00010000, 0x0000123A, 0x00000000, 0xDEADBEEF};
+    static_assert(matches(kWriteRegister, [](PM4Builder& b) { b.writeRegister(0x123A, 0xDEADBEEF); }));
+
+    // Three consecutive context registers collapse into one packet, the jump to 0xA010 starts a new one.
+    constexpr UInt32 kSetContextRegs[] = {0xC0036900, 0x00000001, 0x11, 0x22, 0x33, 0xC0016900, 0x00000010, 0x44};
+    static_assert(matches(kSetContextRegs, [](PM4Builder& b) {
+        b.setReg<PM4RegSpace::Context, 0xA001>(0x11);
+        b.setReg<PM4RegSpace::Context, 0xA002>(0x22);
+        b.setReg<PM4RegSpace::Context, 0xA003>(0x33);
+        b.setReg<PM4RegSpace::Context, 0xA010>(0x44);
+    }));
+
+    // Same offset in another space must not merge.
+    constexpr UInt32 kSetMixedRegs[] = {0xC0017600, 0x00000005, 0x1, 0xC0017900, 0x00000006, 0x2};
+    static_assert(matches(kSetMixedRegs, [](PM4Builder& b) {
+        b.setReg<PM4RegSpace::SH, 0x2C05>(0x1);
+        b.setReg<PM4RegSpace::UConfig, 0xC006>(0x2);
+    }));
+
+    // What `gfx_v9_0_ring_emit_fence` emits for a 32-bit fence with an interrupt...
+    constexpr UInt32 kFence[] = {0xC0064900, 0x00238514, 0x22000000, 0x00001000, 0x00000080, 0x1234, 0x0, 0x0};
+    static_assert(matches(kFence, [](PM4Builder& b) {
+        b.releaseMem(CACHE_FLUSH_AND_INV_TS_EVENT, PACKET3_RELEASE_MEM_CACHE_FLUSH, 0x8000001000,
+                     PACKET3_RELEASE_MEM_DATA_SEL_32, 0x1234, true);
+    }));
+
+    // ...and for a 64-bit writeback-only one without.
+    constexpr UInt32 kFenceWBOnly[] = {0xC0064900, 0x00088514, 0x40000000, 0x00001000,
+                                       0x00000080, 0x23456789, 0x00000001, 0x0};
+    static_assert(matches(kFenceWBOnly, [](PM4Builder& b) {
+        b.releaseMem(CACHE_FLUSH_AND_INV_TS_EVENT, PACKET3_RELEASE_MEM_CACHE_WB_ONLY, 0x8000001000,
+                     PACKET3_RELEASE_MEM_DATA_SEL_64, 0x123456789, false);
+    }));
+
+    constexpr bool rejectsUnknownCacheAction()
+    {
+        UInt32     buffer[8] = {};
+        PM4Builder builder{buffer, 8};
+        builder.releaseMem(CACHE_FLUSH_AND_INV_TS_EVENT, getBit(0), 0x1000, PACKET3_RELEASE_MEM_DATA_SEL_32, 0, false);
+        return !builder.isValid() && builder.getSize() == 0;
+    }
+    static_assert(rejectsUnknownCacheAction());
+
+    constexpr UInt32 kWaitMemory[] = {0xC0053C00, 0x00000013, 0x00002000, 0x00000001, 0x5, 0xFFFFFFFF, 0x4};
+    static_assert(matches(kWaitMemory, [](PM4Builder& b) { b.waitMemoryEqual(0x100002000, 5, 0xFFFFFFFF, 4); }));
+
+    // What `gfx_v9_0_ring_emit_ib_gfx` emits for a 256 dword IB on VMID 3...
+    constexpr UInt32 kIndirectBuffer[] = {0xC0023F00, 0x00400000, 0x00000012, 0x03000100};
+    static_assert(matches(kIndirectBuffer, [](PM4Builder& b) { b.indirectBuffer(0x1200400000, 0x100, 3, false); }));
+
+    // ...and `gfx_v9_0_ring_emit_ib_compute`, which also sets VALID.
+    constexpr UInt32 kIndirectBufferCompute[] = {0xC0023F00, 0x00400000, 0x00000012, 0x03800100};
+    static_assert(
+        matches(kIndirectBufferCompute, [](PM4Builder& b) { b.indirectBuffer(0x1200400000, 0x100, 3, true); }));
+
+    constexpr bool rejectsOverflow()
+    {
+        UInt32     buffer[4] = {};
+        PM4Builder builder{buffer, 4};
+        builder.writeRegister(0x123A, 0);
+        return !builder.isValid() && builder.getSize() == 0;
+    }
+    static_assert(rejectsOverflow());
+
+}    // namespace PM4BuilderTests
@@ -7,8 +7,11 @@
 #include <IOKit/IOTypes.h>
 
 constexpr UInt32 NBIO_BASE_2  = 0xD20;
+constexpr UInt32 SDMA0_BASE_0 = 0x1260;
 constexpr UInt32 GC_BASE_0    = 0x2000;
 constexpr UInt32 DCN_BASE_2   = 0x34C0;
+constexpr UInt32 GC_BASE_1    = 0xA000;
 constexpr UInt32 MP0_BASE_0   = 0x16000;
 constexpr UInt32 SMUIO_BASE_0 = 0x16800;
+constexpr UInt32 MMHUB_BASE_0 = 0x1A000;
 constexpr UInt32 MP1_PUBLIC   = 0x3B00000;
@@ -0,0 +1,35 @@
+// Renoir SMU Metrics Table
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOTypes.h>
+
+constexpr UInt32 SMU12_TABLE_SMU_METRICS = 7;
+
+// The part every SMU 12 firmware agrees on, newer ones only append fields.
+struct SMU12MetricsV0
+{
+    UInt16 gfxclkFrequency;    // MHz
+    UInt16 socclkFrequency;    // MHz
+    UInt16 vclkFrequency;      // MHz
+    UInt16 dclkFrequency;      // MHz
+    UInt16 memclkFrequency;    // MHz
+    UInt16 spare;
+    UInt16 gfxActivity;           // centi-%
+    UInt16 uvdActivity;           // centi-%
+    UInt16 voltage[2];            // mV, VDDCR_VDD and VDDCR_SOC
+    UInt16 current[2];            // mA, VDDCR_VDD and VDDCR_SOC
+    UInt16 power[2];              // mW, VDDCR_VDD and VDDCR_SOC
+    UInt16 coreFrequency[8];      // MHz
+    UInt16 corePower[8];          // mW
+    UInt16 coreTemperature[8];    // centi-°C
+    UInt16 l3Frequency[2];        // MHz
+    UInt16 l3Temperature[2];      // centi-°C
+    UInt16 gfxTemperature;        // centi-°C
+    UInt16 socTemperature;        // centi-°C
+    UInt16 throttlerStatus;
+    UInt16 currentSocketPower;    // mW
+};
+static_assert(sizeof(SMU12MetricsV0) == 0x5C);
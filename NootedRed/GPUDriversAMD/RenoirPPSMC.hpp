@@ -6,11 +6,21 @@
 #pragma once
 #include <IOKit/IOTypes.h>
 
-constexpr UInt32 PPSMC_MSG_GetSmuVersion       = 0x2;
-constexpr UInt32 PPSMC_MSG_PowerUpGfx          = 0x6;
-constexpr UInt32 PPSMC_MSG_PowerUpSdma         = 0xE;
-constexpr UInt32 PPSMC_MSG_DeviceDriverReset   = 0x1E;
-constexpr UInt32 PPSMC_MSG_SoftReset           = 0x2E;
-constexpr UInt32 PPSMC_MSG_PowerGateMmHub      = 0x35;
-constexpr UInt32 PPSMC_MSG_ForceGfxContentSave = 0x39;
-constexpr UInt32 PPSMC_MSG_PowerGateAtHub      = 0x3D;
+constexpr UInt32 PPSMC_MSG_GetSmuVersion         = 0x2;
+constexpr UInt32 PPSMC_MSG_PowerUpGfx            = 0x6;
+constexpr UInt32 PPSMC_MSG_AllowGfxOff           = 0x7;
+constexpr UInt32 PPSMC_MSG_DisallowGfxOff        = 0x8;
+constexpr UInt32 PPSMC_MSG_PowerUpSdma           = 0xE;
+constexpr UInt32 PPSMC_MSG_ActiveProcessNotify   = 0x15;
+constexpr UInt32 PPSMC_MSG_SetDriverDramAddrHigh = 0x1A;
+constexpr UInt32 PPSMC_MSG_SetDriverDramAddrLow  = 0x1B;
+constexpr UInt32 PPSMC_MSG_TransferTableSmu2Dram = 0x1C;
+constexpr UInt32 PPSMC_MSG_DeviceDriverReset     = 0x1E;
+constexpr UInt32 PPSMC_MSG_GetGfxclkFrequency    = 0x2A;
+constexpr UInt32 PPSMC_MSG_GetFclkFrequency      = 0x2B;
+constexpr UInt32 PPSMC_MSG_GetMinGfxclkFrequency = 0x2C;
+constexpr UInt32 PPSMC_MSG_SoftReset             = 0x2E;
+constexpr UInt32 PPSMC_MSG_SetHardMinGfxClk      = 0x31;
+constexpr UInt32 PPSMC_MSG_PowerGateMmHub        = 0x35;
+constexpr UInt32 PPSMC_MSG_ForceGfxContentSave   = 0x39;
+constexpr UInt32 PPSMC_MSG_PowerGateAtHub        = 0x3D;
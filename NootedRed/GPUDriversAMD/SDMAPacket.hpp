@@ -0,0 +1,167 @@
+// AMD SDMA 4.x Packets
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOTypes.h>
+
+constexpr UInt8 SDMA_OP_NOP        = 0;
+constexpr UInt8 SDMA_OP_COPY       = 1;
+constexpr UInt8 SDMA_OP_FENCE      = 5;
+constexpr UInt8 SDMA_OP_TRAP       = 6;
+constexpr UInt8 SDMA_OP_CONST_FILL = 11;
+
+constexpr UInt8 SDMA_SUBOP_COPY_LINEAR = 0;
+
+constexpr UInt32 SDMA_COPY_MAX_BYTES = 0x400000;
+constexpr UInt32 SDMA_FILL_MAX_BYTES = 0x400000;
+
+constexpr UInt32 sdmaPacketHeader(const UInt8 op, const UInt8 subOp) { return op | (static_cast<UInt32>(subOp) << 8); }
+
+// Appends SDMA 4.x packets to a caller-owned buffer, same contract as `PM4Builder`.
+// Copies and fills larger than what one packet can do are split up transparently.
+class SDMAPacketBuilder
+{
+    UInt32* buffer;
+    size_t  capacity;
+    size_t  size{0};
+    bool    valid{true};
+
+    constexpr bool reserve(const size_t dwords)
+    {
+        if (!this->valid || this->capacity - this->size < dwords) {
+            this->valid = false;
+            return false;
+        }
+        return true;
+    }
+
+    constexpr void emit(const UInt32 dword) { this->buffer[this->size++] = dword; }
+
+public:
+    constexpr SDMAPacketBuilder(UInt32* const buffer, const size_t capacity) : buffer{buffer}, capacity{capacity} {}
+
+    constexpr size_t getSize() const { return this->size; }
+    constexpr bool   isValid() const { return this->valid; }
+
+    static constexpr size_t copyLinearDWords(const UInt64 bytes)
+    { return ((bytes + SDMA_COPY_MAX_BYTES - 1) / SDMA_COPY_MAX_BYTES) * 7; }
+
+    static constexpr size_t constantFillDWords(const UInt64 bytes)
+    { return ((bytes + SDMA_FILL_MAX_BYTES - 1) / SDMA_FILL_MAX_BYTES) * 5; }
+
+    constexpr void copyLinear(UInt64 dst, UInt64 src, UInt64 bytes)
+    {
+        if (bytes == 0 || !this->reserve(copyLinearDWords(bytes))) { return; }
+        while (bytes != 0) {
+            const auto chunk = bytes < SDMA_COPY_MAX_BYTES ? static_cast<UInt32>(bytes) : SDMA_COPY_MAX_BYTES;
+            this->emit(sdmaPacketHeader(SDMA_OP_COPY, SDMA_SUBOP_COPY_LINEAR));
+            this->emit(chunk - 1);
+            this->emit(0);
+            this->emit(static_cast<UInt32>(src));
+            this->emit(static_cast<UInt32>(src >> 32));
+            this->emit(static_cast<UInt32>(dst));
+            this->emit(static_cast<UInt32>(dst >> 32));
+            src   += chunk;
+            dst   += chunk;
+            bytes -= chunk;
+        }
+    }
+
+    // Fills whole dwords, so `dst` and `bytes` have to be dword aligned.
+    constexpr void constantFill(UInt64 dst, const UInt32 pattern, UInt64 bytes)
+    {
+        if (bytes == 0 || (dst & 3) != 0 || (bytes & 3) != 0) {
+            this->valid = false;
+            return;
+        }
+        if (!this->reserve(constantFillDWords(bytes))) { return; }
+        while (bytes != 0) {
+            const auto chunk = bytes < SDMA_FILL_MAX_BYTES ? static_cast<UInt32>(bytes) : SDMA_FILL_MAX_BYTES;
+            this->emit(sdmaPacketHeader(SDMA_OP_CONST_FILL, 0));
+            this->emit(static_cast<UInt32>(dst));
+            this->emit(static_cast<UInt32>(dst >> 32));
+            this->emit(pattern);
+            this->emit(chunk - 1);
+            dst   += chunk;
+            bytes -= chunk;
+        }
+    }
+
+    // Writes `value` to `addr` once everything before it has completed.
+    constexpr void fence(const UInt64 addr, const UInt32 value)
+    {
+        if ((addr & 3) != 0) {
+            this->valid = false;
+            return;
+        }
+        if (!this->reserve(4)) { return; }
+        this->emit(sdmaPacketHeader(SDMA_OP_FENCE, 0));
+        this->emit(static_cast<UInt32>(addr));
+        this->emit(static_cast<UInt32>(addr >> 32));
+        this->emit(value);
+    }
+
+    constexpr void trap(const UInt32 context)
+    {
+        if (!this->reserve(2)) { return; }
+        this->emit(sdmaPacketHeader(SDMA_OP_TRAP, 0));
+        this->emit(context & 0xFFFFFFF);
+    }
+
+    // The ring wants submissions padded to a multiple of 8 dwords, a zero dword is a single-dword NOP.
+    constexpr void pad(const size_t alignment = 8)
+    {
+        const auto padding = (alignment - this->size % alignment) % alignment;
+        if (!this->reserve(padding)) { return; }
+        for (size_t i = 0; i < padding; i += 1) { this->emit(sdmaPacketHeader(SDMA_OP_NOP, 0)); }
+    }
+};
+
+namespace SDMAPacketBuilderTests
+{
+
+    template<size_t N, typename F>
+    constexpr bool matches(const UInt32 (&expected)[N], const F& build)
+    {
+        UInt32            buffer[N + 1] = {};
+        SDMAPacketBuilder builder{buffer, N + 1};
+        build(builder);
+        if (!builder.isValid() || builder.getSize() != N) { return false; }
+        for (size_t i = 0; i < N; i += 1) {
+            if (buffer[i] != expected[i]) { return false; }
+        }
+        return true;
+    }
+
+    constexpr UInt32 kCopyLinear[] = {0x00000001, 0x00000FFF, 0x0, 0x00002000, 0x00000001, 0x00004000, 0x00000002};
+    static_assert(matches(kCopyLinear, [](SDMAPacketBuilder& b) { b.copyLinear(0x200004000, 0x100002000, 0x1000); }));
+
+    // 5MiB splits into a full 4MiB packet and a 1MiB one.
+    constexpr UInt32 kCopySplit[] = {
+        0x00000001, 0x003FFFFF, 0x0, 0x00000000, 0x0, 0x10000000, 0x0,
+        0x00000001, 0x000FFFFF, 0x0, 0x00400000, 0x0, 0x10400000, 0x0,
+    };
+    static_assert(matches(kCopySplit, [](SDMAPacketBuilder& b) { b.copyLinear(0x10000000, 0, 0x500000); }));
+
+    constexpr UInt32 kConstantFill[] = {0x0000000B, 0x00001000, 0x00000000, 0xDEADBEEF, 0x000000FF};
+    static_assert(matches(kConstantFill, [](SDMAPacketBuilder& b) { b.constantFill(0x1000, 0xDEADBEEF, 0x100); }));
+
+    constexpr UInt32 kFenceTrapPadded[] = {0x00000005, 0x00000100, 0x00000001, 0x2A, 0x00000006, 0x0, 0x0, 0x0};
+    static_assert(matches(kFenceTrapPadded, [](SDMAPacketBuilder& b) {
+        b.fence(0x100000100, 42);
+        b.trap(0);
+        b.pad();
+    }));
+
+    constexpr bool rejectsUnalignedFill()
+    {
+        UInt32            buffer[8] = {};
+        SDMAPacketBuilder builder{buffer, 8};
+        builder.constantFill(0x1002, 0, 0x10);
+        return !builder.isValid() && builder.getSize() == 0;
+    }
+    static_assert(rejectsUnalignedFill());
+
+}    // namespace SDMAPacketBuilderTests
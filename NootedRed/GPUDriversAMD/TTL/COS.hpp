@@ -23,5 +23,3 @@ enum COSResult
     kCOSResultUnsupported = 2,
 };
 
-typedef bool CosWaitForFunc(void* handle);
-
@@ -4,6 +4,7 @@
 // See LICENSE for details.
 
 #pragma once
+#include <GPUDriversAMD/PSP.hpp>
 #include <IOKit/IOTypes.h>
 
 enum DMCUFirmwareType
@@ -22,6 +23,7 @@ struct DMCUFirmwareConstant
 };
 
 #define DMCU_FW_CONSTANT(_LA, _R)                                                                         \
+    static_assert(pspFirmwareIsValid(_##_R), "Malformed firmware image: " #_R);                           \
     static const DMCUFirmwareConstant _R { .loadAddress = (_LA), .romSize = sizeof(_##_R), .rom = _##_R }
 
 struct DMCUFirmwareEntry
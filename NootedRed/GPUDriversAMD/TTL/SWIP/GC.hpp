@@ -4,6 +4,7 @@
 // See LICENSE for details.
 
 #pragma once
+#include <GPUDriversAMD/PSP.hpp>
 #include <IOKit/IOTypes.h>
 
 enum GCFirmwareType
@@ -46,16 +47,24 @@ struct GCFirmwareConstant
     UInt16      field2C;
     UInt16      field2E;
     UInt32      payloadOffDWords;
+    UInt32      versionNumber;    // NootedRed: `version` folded at compile time, lives in the padding.
 };
+static_assert(sizeof(GCFirmwareConstant) == 0x38);
 
-#define GC_FW_CONSTANT(_V, _F8, _APO, _PSD, _F18, _F1C, _R, _C, _F2C, _F2E, _PO)                           \
-    static const GCFirmwareConstant _R                                                                     \
-    {                                                                                                      \
-        .version = (_V), .field8 = (_F8), .romSize = sizeof(_##_R), .actualPayloadOffDWords = (_APO),      \
-        .payloadSizeDWords = (_PSD), .field18 = (_F18), .field1C = (_F1C), .rom = _##_R, .checksum = (_C), \
-        .field2C = (_F2C), .field2E = (_F2E), .payloadOffDWords = (_PO),                                   \
+#define GC_FW_CONSTANT_V(_VN, _F8, _APO, _PSD, _F18, _F1C, _R, _C, _F2C, _F2E, _PO)                          \
+    static_assert(pspFirmwareIsValid(_##_R), "Malformed firmware image: " #_R);                              \
+    static constexpr PSPFirmwareVersionString _R##_version{(_VN), '#'};                                      \
+    static const GCFirmwareConstant           _R                                                             \
+    {                                                                                                        \
+        .version = _R##_version.value, .field8 = (_F8), .romSize = sizeof(_##_R),                            \
+        .actualPayloadOffDWords = (_APO), .payloadSizeDWords = (_PSD), .field18 = (_F18), .field1C = (_F1C), \
+        .rom = _##_R, .checksum = (_C), .field2C = (_F2C), .field2E = (_F2E), .payloadOffDWords = (_PO),     \
+        .versionNumber = (_VN),                                                                              \
     }
 
+#define GC_FW_CONSTANT(_F8, _APO, _PSD, _F18, _F1C, _R, _C, _F2C, _F2E, _PO)                          \
+    GC_FW_CONSTANT_V(pspFirmwareVersion(_##_R), _F8, _APO, _PSD, _F18, _F1C, _R, _C, _F2C, _F2E, _PO)
+
 struct GCFirmwareInfo
 {
     UInt32                    count;
@@ -4,6 +4,7 @@
 // See LICENSE for details.
 
 #pragma once
+#include <GPUDriversAMD/PSP.hpp>
 #include <IOKit/IOTypes.h>
 
 struct SDMAFWConstant
@@ -16,12 +17,14 @@ struct SDMAFWConstant
     UInt32      checksum;
 };
 
-#define SDMA_FW_CONSTANT(_V, _R, _F18, _POD, _C) \
-    static const SDMAFWConstant _R = {           \
-        .version          = (_V),                \
-        .romSize          = sizeof(_##_R),       \
-        .rom              = _##_R,               \
-        .field18          = (_F18),              \
-        .payloadOffDWords = (_POD),              \
-        .checksum         = (_C),                \
+#define SDMA_FW_CONSTANT(_R, _F18, _POD, _C)                                                 \
+    static_assert(pspFirmwareIsValid(_##_R), "Malformed firmware image: " #_R);              \
+    static constexpr PSPFirmwareVersionString _R##_version{pspFirmwareVersion(_##_R), '\0'}; \
+    static const SDMAFWConstant               _R = {                                         \
+        .version          = _R##_version.value,                                              \
+        .romSize          = sizeof(_##_R),                                                   \
+        .rom              = _##_R,                                                           \
+        .field18          = (_F18),                                                          \
+        .payloadOffDWords = (_POD),                                                          \
+        .checksum         = (_C),                                                            \
     }
@@ -0,0 +1,104 @@
+// GPU Utilization Sampler
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <GPUDriversAMD/RavenIPOffset.hpp>
+#include <GPUUtilization.hpp>
+#include <GfxOff.hpp>
+#include <NRed.hpp>
+#include <PenguinWizardry/Stats.hpp>
+#include <libkern/c++/OSDictionary.h>
+
+template<size_t N>
+static constexpr GPUUtilizationWindow accumulate(const GPUStatusSample (&samples)[N])
+{
+    GPUUtilizationWindow ret{};
+    for (const auto& sample : samples) { ret.add(sample); }
+    return ret;
+}
+
+static constexpr GPUStatusSample kIdle           = {true, 0x00000000, 0x00000000, SDMA0_STATUS_REG_IDLE};
+static constexpr GPUStatusSample kGfxOff         = {false, 0xFFFFFFFF, 0xFFFFFFFF, SDMA0_STATUS_REG_IDLE};
+static constexpr GPUStatusSample kDrawing        = {true, 0xA4004000, 0x42000000, SDMA0_STATUS_REG_IDLE};
+static constexpr GPUStatusSample kCopying        = {false, 0, 0, 0};
+static constexpr GPUStatusSample kFellOff        = {true, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF};
+static constexpr GPUStatusSample kStream[]       = {kIdle, kDrawing, kDrawing, kGfxOff, kFellOff};
+static constexpr GPUStatusSample kCopyStream[]   = {kCopying, kCopying, kIdle};
+static constexpr GPUStatusSample kBrokenStream[] = {kFellOff};
+
+static_assert(accumulate(kStream).samples == 4);
+static_assert(accumulate(kStream).percent(kGPUBlockGfx) == 50);
+static_assert(accumulate(kStream).percent(kGPUBlockCP) == 50);
+static_assert(accumulate(kStream).percent(kGPUBlockTA) == 50);
+static_assert(accumulate(kStream).percent(kGPUBlockDB) == 50);
+static_assert(accumulate(kStream).percent(kGPUBlockSDMA) == 0);
+static_assert(accumulate(kCopyStream).percent(kGPUBlockSDMA) == 67);
+static_assert(accumulate(kCopyStream).percent(kGPUBlockGfx) == 0);
+static_assert(accumulate(kBrokenStream).percent(kGPUBlockGfx) == 0);
+
+static GPUUtilization moduleInstance;
+
+GPUUtilization& GPUUtilization::singleton() { return moduleInstance; }
+
+void GPUUtilization::init()
+{
+    if (this->sampler.isEnabled() || !checkKernelArgument("-NRedGPUUtil")) { return; }
+
+    this->sampler.init("GPUUtilization", this, &GPUUtilization::sampleLocked, SAMPLE_INTERVAL_MS);
+    SYSLOG("GPUUtilization", "Enabled");
+}
+
+void GPUUtilization::start()
+{
+    if (!this->sampler.isEnabled()) { return; }
+
+    this->sampler.start([this] {
+        this->window = {};
+        return true;
+    });
+}
+
+void GPUUtilization::stop()
+{
+    if (!this->sampler.isEnabled()) { return; }
+
+    this->sampler.stop([] {});
+}
+
+void GPUUtilization::publish(const GPUUtilizationWindow& window)
+{
+    auto* const stats = OSDictionary::withCapacity(1 + kGPUBlockCount);
+    if (stats == nullptr) { return; }
+
+    PenguinWizardry::setStatsNumber(stats, "Device Utilization %", window.percent(kGPUBlockGfx));
+    PenguinWizardry::setStatsNumber(stats, "GFX Busy %", window.percent(kGPUBlockGfx));
+    PenguinWizardry::setStatsNumber(stats, "CP Busy %", window.percent(kGPUBlockCP));
+    PenguinWizardry::setStatsNumber(stats, "SDMA Busy %", window.percent(kGPUBlockSDMA));
+    PenguinWizardry::setStatsNumber(stats, "TA Busy %", window.percent(kGPUBlockTA));
+    PenguinWizardry::setStatsNumber(stats, "DB Busy %", window.percent(kGPUBlockDB));
+    NRed::singleton().mergePerformanceStatistics(stats);
+    stats->release();
+}
+
+bool GPUUtilization::sampleLocked()
+{
+    const auto&     nred   = NRed::singleton();
+    GPUStatusSample sample = {
+        .gcPowered     = false,
+        .grbmStatus    = 0,
+        .grbmStatusSE0 = 0,
+        .sdmaStatus    = nred.readReg32(SDMA0_BASE_0 + SDMA0_STATUS_REG),
+    };
+    // Holding a GFXOFF reference here would keep GC awake just to find out it is idle.
+    sample.gcPowered = GfxOff::singleton().ifPowered([&nred, &sample] {
+        sample.grbmStatus    = nred.readReg32(GC_BASE_0 + GRBM_STATUS);
+        sample.grbmStatusSE0 = nred.readReg32(GC_BASE_0 + GRBM_STATUS_SE0);
+    });
+    this->window.add(sample);
+    if (this->window.samples == WINDOW_SAMPLES) {
+        publish(this->window);
+        this->window = {};
+    }
+    return true;
+}
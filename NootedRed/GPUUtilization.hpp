@@ -0,0 +1,97 @@
+// GPU Utilization Sampler
+// Polls the GRBM and SDMA status registers and publishes how often each block was busy
+// as part of the accelerator's `PerformanceStatistics`.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <Headers/kern_util.hpp>
+#include <IOKit/IOTypes.h>
+#include <PenguinWizardry/PeriodicCall.hpp>
+#include <Regs/GC.hpp>
+#include <Regs/SDMA0.hpp>
+
+enum GPUBlock : UInt32
+{
+    kGPUBlockGfx = 0,
+    kGPUBlockCP,
+    kGPUBlockSDMA,
+    kGPUBlockTA,
+    kGPUBlockDB,
+    kGPUBlockCount,
+};
+
+struct GPUStatusSample
+{
+    bool   gcPowered;    // With GC under GFXOFF the GRBM registers can't be read, and nothing on it is busy.
+    UInt32 grbmStatus;
+    UInt32 grbmStatusSE0;
+    UInt32 sdmaStatus;
+};
+
+struct GPUUtilizationWindow
+{
+    UInt32 samples{0};
+    UInt32 busy[kGPUBlockCount]{};
+
+    // Reads of a block that just fell off the bus come back as all ones, those samples are dropped.
+    static constexpr bool isValid(const GPUStatusSample& sample)
+    {
+        return sample.sdmaStatus != 0xFFFFFFFF
+               && (!sample.gcPowered || (sample.grbmStatus != 0xFFFFFFFF && sample.grbmStatusSE0 != 0xFFFFFFFF));
+    }
+
+    static constexpr UInt32 busyBlocks(const GPUStatusSample& sample)
+    {
+        UInt32 ret = 0;
+        if ((sample.sdmaStatus & SDMA0_STATUS_REG_IDLE) == 0) { ret |= getBit(kGPUBlockSDMA); }
+        if (!sample.gcPowered) { return ret; }
+        if ((sample.grbmStatus & GRBM_STATUS_GUI_ACTIVE) != 0) { ret |= getBit(kGPUBlockGfx); }
+        if ((sample.grbmStatus & (GRBM_STATUS_CP_BUSY | GRBM_STATUS_CP_COHERENCY_BUSY)) != 0) {
+            ret |= getBit(kGPUBlockCP);
+        }
+        if ((sample.grbmStatus & GRBM_STATUS_TA_BUSY) != 0 || (sample.grbmStatusSE0 & GRBM_STATUS_SE0_TA_BUSY) != 0) {
+            ret |= getBit(kGPUBlockTA);
+        }
+        if ((sample.grbmStatus & GRBM_STATUS_DB_BUSY) != 0 || (sample.grbmStatusSE0 & GRBM_STATUS_SE0_DB_BUSY) != 0) {
+            ret |= getBit(kGPUBlockDB);
+        }
+        return ret;
+    }
+
+    constexpr void add(const GPUStatusSample& sample)
+    {
+        if (!isValid(sample)) { return; }
+        this->samples += 1;
+        const auto blocks = busyBlocks(sample);
+        for (UInt32 block = 0; block < kGPUBlockCount; block += 1) {
+            if ((blocks & getBit(block)) != 0) { this->busy[block] += 1; }
+        }
+    }
+
+    // Rounded to the nearest percent, 0 for an empty window.
+    constexpr UInt32 percent(const GPUBlock block) const
+    { return this->samples == 0 ? 0 : (this->busy[block] * 100 + this->samples / 2) / this->samples; }
+};
+
+class GPUUtilization
+{
+    static constexpr UInt32 SAMPLE_INTERVAL_MS = 20;
+    static constexpr UInt32 WINDOW_SAMPLES     = 50;
+
+    PenguinWizardry::PeriodicCall<GPUUtilization> sampler{};
+    GPUUtilizationWindow                          window{};
+
+public:
+    static GPUUtilization& singleton();
+
+    // Opt-in through `-NRedGPUUtil`, everything below is a no-op otherwise.
+    void init();
+    void start();
+    void stop();
+
+private:
+    bool        sampleLocked();
+    static void publish(const GPUUtilizationWindow& window);
+};
@@ -0,0 +1,19 @@
+// GFX Access Coalescing
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <GfxAccess.hpp>
+#include <Headers/kern_util.hpp>
+
+static GfxAccessTracker moduleInstance;
+
+GfxAccessTracker& GfxAccessTracker::singleton() { return moduleInstance; }
+
+void GfxAccessTracker::init()
+{
+    if (this->enabled || !checkKernelArgument("-NRedGfxAccessCoalesce")) { return; }
+
+    this->enabled = true;
+    SYSLOG("GfxAccess", "Coalescing access notifications");
+}
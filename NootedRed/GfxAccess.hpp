@@ -0,0 +1,44 @@
+// GFX Access Coalescing
+// Lets submissions skip `notifyGfxAccess` while GC is known to be awake.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOTypes.h>
+
+// Every report of GC going idle starts a new generation, only the first submission of a generation has to notify.
+// The accelerator may still idle GC without telling us, so this is opt-in, and a notification is never skipped for
+// longer than `REFRESH_US` even then.
+class GfxAccessTracker
+{
+    static constexpr UInt64 REFRESH_US = 5000;
+
+    bool   enabled{false};
+    UInt32 idleGeneration{1};
+    UInt32 notifiedGeneration{0};
+    UInt64 notifiedAtUs{0};
+
+public:
+    static GfxAccessTracker& singleton();
+
+    // Opt-in through `-NRedGfxAccessCoalesce`, every submission notifies otherwise.
+    void init();
+
+    void noteIdle() { __atomic_fetch_add(&this->idleGeneration, 1, __ATOMIC_RELEASE); }
+
+    // Racing submitters may both get `true`, which only costs a redundant notification.
+    bool shouldNotify(const UInt64 nowUs)
+    {
+        if (!this->enabled) { return true; }
+        const auto generation = __atomic_load_n(&this->idleGeneration, __ATOMIC_ACQUIRE);
+        if (generation == __atomic_load_n(&this->notifiedGeneration, __ATOMIC_RELAXED)
+            && nowUs - __atomic_load_n(&this->notifiedAtUs, __ATOMIC_RELAXED) < REFRESH_US)
+        {
+            return false;
+        }
+        __atomic_store_n(&this->notifiedAtUs, nowUs, __ATOMIC_RELAXED);
+        __atomic_store_n(&this->notifiedGeneration, generation, __ATOMIC_RELEASE);
+        return true;
+    }
+};
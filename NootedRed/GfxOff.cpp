@@ -0,0 +1,117 @@
+// GFXOFF Control
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+// Allow/DisallowGfxOff have the same IDs on Raven, so the Renoir header covers both.
+#include <GPUDriversAMD/RavenIPOffset.hpp>
+#include <GPUDriversAMD/RenoirPPSMC.hpp>
+#include <GfxAccess.hpp>
+#include <GfxOff.hpp>
+#include <Headers/kern_util.hpp>
+#include <NRed.hpp>
+#include <PenguinWizardry/KernelVersion.hpp>
+#include <Regs/GC.hpp>
+#include <SMUQueue.hpp>
+#include <pexpert/pexpert.h>
+
+static GfxOff moduleInstance;
+
+GfxOff& GfxOff::singleton() { return moduleInstance; }
+
+void GfxOff::init()
+{
+    if (this->idle.isEnabled() || !checkKernelArgument("-NRedGfxOff")) { return; }
+    // Older accelerators have no `notifyGfxAccess` to hook, so their own GC accesses couldn't be covered.
+    if (currentKernelVersion() < MACOS_11) {
+        SYSLOG("GfxOff", "Requires macOS 11 or newer");
+        return;
+    }
+
+    PE_parse_boot_argn("NRedGfxOffDelay", &this->delayMs, sizeof(this->delayMs));
+    this->idle.init("GfxOff", this, &GfxOff::idleLocked, this->delayMs);
+    SYSLOG("GfxOff", "Enabled with a %ums quiet period", this->delayMs);
+}
+
+void GfxOff::start(void* const ctx)
+{
+    if (!this->idle.isEnabled()) { return; }
+
+    this->idle.start([this, ctx] {
+        this->ctx     = ctx;
+        this->allowed = false;
+        return this->refCount == 0;
+    });
+}
+
+void GfxOff::stop()
+{
+    if (!this->idle.isEnabled()) { return; }
+
+    this->idle.stop([this] {
+        this->ctx     = nullptr;
+        this->allowed = false;
+    });
+}
+
+void GfxOff::get()
+{
+    if (!this->idle.isEnabled()) { return; }
+
+    auto* const lock = this->idle.getLock();
+    IOLockLock(lock);
+    this->refCount += 1;
+    if (this->refCount == 1) { this->idle.cancelLocked(); }
+    while (this->switching) { IOLockSleep(lock, &this->switching, THREAD_UNINT); }
+    if (this->allowed) {
+        const auto res = this->sendUnlocked(PPSMC_MSG_DisallowGfxOff);
+        SYSLOG_COND(res != kCAILResultOK, "GfxOff", "Failed to disallow GFXOFF: 0x%X", res);
+        this->allowed = false;
+    }
+    IOLockUnlock(lock);
+}
+
+// Re-arming the pending idle call pushes its deadline out, so every `put` restarts the quiet period.
+void GfxOff::put()
+{
+    if (!this->idle.isEnabled()) { return; }
+
+    IOLockLock(this->idle.getLock());
+    PANIC_COND(this->refCount == 0, "GfxOff", "Unbalanced put");
+    this->refCount -= 1;
+    if (this->refCount == 0 && this->ctx != nullptr) { this->idle.armLocked(); }
+    IOLockUnlock(this->idle.getLock());
+}
+
+// Called and returns with the lock held. Anyone else who needs GC waits for `switching` to clear, the rest, e.g.
+// `ifPowered`, doesn't have to wait for the mailbox.
+CAILResult GfxOff::sendUnlocked(const UInt32 message)
+{
+    auto* const ctx  = this->ctx;
+    auto* const lock = this->idle.getLock();
+    this->switching  = true;
+    IOLockUnlock(lock);
+    const auto res = SMUQueue::singleton().send(ctx, message);
+    IOLockLock(lock);
+    this->switching = false;
+    IOLockWakeup(lock, &this->switching, false);
+    return res;
+}
+
+// The accelerator calls `notifyGfxAccess` before it uses GC, but never says when it's done. GC is kept up for as long
+// as the GRBM reports it busy, so work submitted before the quiet period ran out still finishes with GC powered.
+bool GfxOff::idleLocked()
+{
+    if (this->refCount != 0 || this->allowed || this->switching) { return false; }
+    if ((NRed::singleton().readReg32(GC_BASE_0 + GRBM_STATUS) & GRBM_STATUS_GUI_ACTIVE) != 0) { return true; }
+
+    const auto res = this->sendUnlocked(PPSMC_MSG_AllowGfxOff);
+    if (res == kCAILResultOK) {
+        this->allowed = true;
+        GfxAccessTracker::singleton().noteIdle();
+    }
+    else {
+        SYSLOG("GfxOff", "Failed to allow GFXOFF: 0x%X", res);
+    }
+    return false;
+}
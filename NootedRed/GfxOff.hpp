@@ -0,0 +1,64 @@
+// GFXOFF Control
+// Lets the SMU power off GC while nothing is using it, after a quiet period.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <GPUDriversAMD/CAIL/Result.hpp>
+#include <IOKit/IOTypes.h>
+#include <PenguinWizardry/PeriodicCall.hpp>
+
+// Anything touching GC registers has to hold a reference, GFXOFF is only allowed while there are none.
+class GfxOff
+{
+    static constexpr UInt32 DEFAULT_DELAY_MS = 100;
+
+    PenguinWizardry::PeriodicCall<GfxOff> idle{};          // Only armed while nothing holds a reference.
+    void*                                 ctx{nullptr};    // Non-null while the SMU is up.
+    UInt32                                delayMs{DEFAULT_DELAY_MS};
+    UInt32                                refCount{0};
+    bool                                  allowed{false};      // The SMU starts out with GFXOFF disallowed.
+    bool                                  switching{false};    // A message is in flight, sent without the lock.
+
+public:
+    static GfxOff& singleton();
+
+    // Opt-in through `-NRedGfxOff` on macOS 11 and newer, the quiet period can be changed with `NRedGfxOffDelay=<ms>`.
+    void init();
+    void start(void* ctx);
+    void stop();
+
+    // `get` only returns once GC is powered. Waking GC up is an SMU round trip, only callers that need GC wait for it.
+    void get();
+    void put();
+
+    // Runs `fn` only while GC is known to be powered, without restarting the quiet period like `get` does.
+    template<typename F>
+    bool ifPowered(const F& fn)
+    {
+        if (!this->idle.isEnabled()) {
+            fn();
+            return true;
+        }
+        IOLockLock(this->idle.getLock());
+        const bool powered = this->ctx != nullptr && !this->allowed && !this->switching;
+        if (powered) { fn(); }
+        IOLockUnlock(this->idle.getLock());
+        return powered;
+    }
+
+private:
+    CAILResult sendUnlocked(UInt32 message);
+    bool       idleLocked();
+};
+
+class GfxOffGuard
+{
+public:
+    GfxOffGuard() { GfxOff::singleton().get(); }
+    ~GfxOffGuard() { GfxOff::singleton().put(); }
+
+    GfxOffGuard(const GfxOffGuard&)            = delete;
+    GfxOffGuard& operator=(const GfxOffGuard&) = delete;
+};
@@ -9,7 +9,89 @@
 #include <Regs/GC.hpp>
 #include <Regs/SDMA0.hpp>
 
-static const CAILGoldenRegister gcGoldenSettingsRaven[] = {
+// GFX9 semantics, only the bits in `andMask` are replaced.
+constexpr UInt32 applyGoldenRegister(const UInt32 value, const CAILGoldenRegister& reg)
+{
+    return (value & ~reg.andMask) | (reg.orMask & reg.andMask);
+}
+
+constexpr bool isSameGoldenRegister(const CAILGoldenRegister& lhs, const CAILGoldenRegister& rhs)
+{
+    return lhs.segment == rhs.segment && lhs.regOffset == rhs.regOffset;
+}
+
+template<size_t N>
+struct GoldenRegisterTable
+{
+    CAILGoldenRegister entries[N];
+    size_t             count;
+};
+
+// Folds all entries for a register into one and sorts them by segment and offset, so CAIL only does a single
+// read-modify-write per register. The slots left over stay terminators.
+template<size_t N>
+constexpr GoldenRegisterTable<N> mergeGoldenRegisters(const CAILGoldenRegister (&sequence)[N])
+{
+    GoldenRegisterTable<N> ret{};
+    for (auto& entry : ret.entries) { entry = CAILGoldenRegister GOLDEN_REGISTER_TERMINATOR; }
+
+    for (size_t i = 0; i < N && sequence[i].regOffset != 0xFFFFFFFF; i += 1) {
+        const auto& reg = sequence[i];
+        size_t      j   = 0;
+        while (j < ret.count && !isSameGoldenRegister(ret.entries[j], reg)) { j += 1; }
+        if (j == ret.count) {
+            ret.entries[ret.count] = reg;
+            ret.count += 1;
+            continue;
+        }
+        auto& merged   = ret.entries[j];
+        merged.orMask  = (merged.orMask & merged.andMask & ~reg.andMask) | (reg.orMask & reg.andMask);
+        merged.andMask = merged.andMask | reg.andMask;
+    }
+
+    for (size_t i = 1; i < ret.count; i += 1) {
+        const auto reg = ret.entries[i];
+        size_t     j   = i;
+        for (; j > 0
+               && (ret.entries[j - 1].segment > reg.segment
+                   || (ret.entries[j - 1].segment == reg.segment && ret.entries[j - 1].regOffset > reg.regOffset));
+             j -= 1) {
+            ret.entries[j] = ret.entries[j - 1];
+        }
+        ret.entries[j] = reg;
+    }
+    return ret;
+}
+
+// Checked at build time for every table: from a few starting values, each register must end up exactly where applying
+// the original sequence one entry at a time would leave it.
+template<size_t N>
+constexpr bool isGoldenRegisterMergeEquivalent(const CAILGoldenRegister (&sequence)[N],
+                                               const GoldenRegisterTable<N>& merged)
+{
+    constexpr UInt32 initialValues[] = {0x0, 0xFFFFFFFF, 0x5A5A5A5A, 0xA5A5A5A5};
+    if (merged.count >= N || merged.entries[merged.count].regOffset != 0xFFFFFFFF) { return false; }
+    for (size_t i = 0; i < N && sequence[i].regOffset != 0xFFFFFFFF; i += 1) {
+        for (const auto initial : initialValues) {
+            UInt32 expected = initial;
+            for (size_t j = 0; j < N && sequence[j].regOffset != 0xFFFFFFFF; j += 1) {
+                if (isSameGoldenRegister(sequence[j], sequence[i])) {
+                    expected = applyGoldenRegister(expected, sequence[j]);
+                }
+            }
+            size_t found = 0;
+            for (size_t j = 0; j < merged.count; j += 1) {
+                if (!isSameGoldenRegister(merged.entries[j], sequence[i])) { continue; }
+                found += 1;
+                if (applyGoldenRegister(initial, merged.entries[j]) != expected) { return false; }
+            }
+            if (found != 1) { return false; }
+        }
+    }
+    return true;
+}
+
+static constexpr CAILGoldenRegister gcGoldenSettingsRaven[] = {
     GOLDEN_REGISTER(DB_DEBUG2, 0xF00FFFFF, 0x400),
     GOLDEN_REGISTER(DB_DEBUG3, 0x80000000, 0x80000000),
     GOLDEN_REGISTER(GB_GPU_ID, 0xF, 0x0),
@@ -48,7 +130,7 @@ static const CAILGoldenRegister gcGoldenSettingsRaven[] = {
     GOLDEN_REGISTER_TERMINATOR,
 };
 
-static const CAILGoldenRegister gcGoldenSettingsRaven2[] = {
+static constexpr CAILGoldenRegister gcGoldenSettingsRaven2[] = {
     GOLDEN_REGISTER(DB_DEBUG2, 0xF00FFFFF, 0x400),
     GOLDEN_REGISTER(DB_DEBUG3, 0x80000000, 0x80000000),
     GOLDEN_REGISTER(GB_GPU_ID, 0xF, 0x0),
@@ -86,7 +168,7 @@ static const CAILGoldenRegister gcGoldenSettingsRaven2[] = {
     GOLDEN_REGISTER_TERMINATOR,
 };
 
-static const CAILGoldenRegister gcGoldenSettingsRenoir[] = {
+static constexpr CAILGoldenRegister gcGoldenSettingsRenoir[] = {
     GOLDEN_REGISTER(CB_HW_CONTROL, 0xFFFDF3CF, 0x14104),
     GOLDEN_REGISTER(CB_HW_CONTROL_2, 0xFF7FFFFF, 0xA000000),
     GOLDEN_REGISTER(DB_DEBUG2, 0xF00FFFFF, 0x400),
@@ -102,7 +184,7 @@ static const CAILGoldenRegister gcGoldenSettingsRenoir[] = {
     GOLDEN_REGISTER_TERMINATOR,
 };
 
-static const CAILGoldenRegister sdmaGoldenSettingsRaven[] = {
+static constexpr CAILGoldenRegister sdmaGoldenSettingsRaven[] = {
     GOLDEN_REGISTER(SDMA0_CHICKEN_BITS, 0xFE931F07, 0x2831D07),
     GOLDEN_REGISTER(SDMA0_CLK_CTRL, 0xFFFFFFFF, 0x3F000100),
     GOLDEN_REGISTER(SDMA0_GFX_IB_CNTL, 0x800F0111, 0x100),
@@ -119,7 +201,7 @@ static const CAILGoldenRegister sdmaGoldenSettingsRaven[] = {
     GOLDEN_REGISTER_TERMINATOR,
 };
 
-static const CAILGoldenRegister sdmaGoldenSettingsRaven2[] = {
+static constexpr CAILGoldenRegister sdmaGoldenSettingsRaven2[] = {
     GOLDEN_REGISTER(SDMA0_CHICKEN_BITS, 0xFE931F07, 0x2831D07),
     GOLDEN_REGISTER(SDMA0_CLK_CTRL, 0xFFFFFFFF, 0x3F000100),
     GOLDEN_REGISTER(SDMA0_GFX_IB_CNTL, 0x800F0111, 0x100),
@@ -136,7 +218,7 @@ static const CAILGoldenRegister sdmaGoldenSettingsRaven2[] = {
     GOLDEN_REGISTER_TERMINATOR,
 };
 
-static const CAILGoldenRegister sdmaGoldenSettingsRenoir[] = {
+static constexpr CAILGoldenRegister sdmaGoldenSettingsRenoir[] = {
     GOLDEN_REGISTER(SDMA0_CHICKEN_BITS, 0xFE931F07, 0x2831F07),
     GOLDEN_REGISTER(SDMA0_CLK_CTRL, 0xFFFFFFFF, 0x3F000100),
     GOLDEN_REGISTER(SDMA0_GB_ADDR_CONFIG, 0x18773F, 0x2),
@@ -151,20 +233,38 @@ static const CAILGoldenRegister sdmaGoldenSettingsRenoir[] = {
     GOLDEN_REGISTER_TERMINATOR,
 };
 
+static constexpr auto gcGoldenSettingsRavenMerged = mergeGoldenRegisters(gcGoldenSettingsRaven);
+static_assert(isGoldenRegisterMergeEquivalent(gcGoldenSettingsRaven, gcGoldenSettingsRavenMerged));
+
+static constexpr auto gcGoldenSettingsRaven2Merged = mergeGoldenRegisters(gcGoldenSettingsRaven2);
+static_assert(isGoldenRegisterMergeEquivalent(gcGoldenSettingsRaven2, gcGoldenSettingsRaven2Merged));
+
+static constexpr auto gcGoldenSettingsRenoirMerged = mergeGoldenRegisters(gcGoldenSettingsRenoir);
+static_assert(isGoldenRegisterMergeEquivalent(gcGoldenSettingsRenoir, gcGoldenSettingsRenoirMerged));
+
+static constexpr auto sdmaGoldenSettingsRavenMerged = mergeGoldenRegisters(sdmaGoldenSettingsRaven);
+static_assert(isGoldenRegisterMergeEquivalent(sdmaGoldenSettingsRaven, sdmaGoldenSettingsRavenMerged));
+
+static constexpr auto sdmaGoldenSettingsRaven2Merged = mergeGoldenRegisters(sdmaGoldenSettingsRaven2);
+static_assert(isGoldenRegisterMergeEquivalent(sdmaGoldenSettingsRaven2, sdmaGoldenSettingsRaven2Merged));
+
+static constexpr auto sdmaGoldenSettingsRenoirMerged = mergeGoldenRegisters(sdmaGoldenSettingsRenoir);
+static_assert(isGoldenRegisterMergeEquivalent(sdmaGoldenSettingsRenoir, sdmaGoldenSettingsRenoirMerged));
+
 static const CAILIPGoldenRegisters goldenSettingsRaven[] = {
-    GOLDEN_REGISTERS(GC, gcGoldenSettingsRaven),
-    GOLDEN_REGISTERS(SDMA0, sdmaGoldenSettingsRaven),
+    GOLDEN_REGISTERS(GC, gcGoldenSettingsRavenMerged.entries),
+    GOLDEN_REGISTERS(SDMA0, sdmaGoldenSettingsRavenMerged.entries),
     GOLDEN_REGISTERS_TERMINATOR,
 };
 
 static const CAILIPGoldenRegisters goldenSettingsRaven2[] = {
-    GOLDEN_REGISTERS(GC, gcGoldenSettingsRaven2),
-    GOLDEN_REGISTERS(SDMA0, sdmaGoldenSettingsRaven2),
+    GOLDEN_REGISTERS(GC, gcGoldenSettingsRaven2Merged.entries),
+    GOLDEN_REGISTERS(SDMA0, sdmaGoldenSettingsRaven2Merged.entries),
     GOLDEN_REGISTERS_TERMINATOR,
 };
 
 static const CAILIPGoldenRegisters goldenSettingsRenoir[] = {
-    GOLDEN_REGISTERS(GC, gcGoldenSettingsRenoir),
-    GOLDEN_REGISTERS(SDMA0, sdmaGoldenSettingsRenoir),
+    GOLDEN_REGISTERS(GC, gcGoldenSettingsRenoirMerged.entries),
+    GOLDEN_REGISTERS(SDMA0, sdmaGoldenSettingsRenoirMerged.entries),
     GOLDEN_REGISTERS_TERMINATOR,
 };
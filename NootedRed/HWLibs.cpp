@@ -5,6 +5,8 @@
 
 #include "GoldenSettings.hpp"
 #include <ASICCaps.hpp>
+#include <ClockGating.hpp>
+#include <DPMBoost.hpp>
 #include <GPUDriversAMD/CAIL/ASICCaps.hpp>
 #include <GPUDriversAMD/CAIL/DevCaps.hpp>
 #include <GPUDriversAMD/CAIL/DeviceType.hpp>
@@ -19,230 +21,401 @@
 #include <GPUDriversAMD/TTL/SWIP/IPVersion.hpp>
 #include <GPUDriversAMD/TTL/SWIP/SDMA.hpp>
 #include <GPUDriversAMD/TTL/SWIP/SMU.hpp>
+#include <GPUUtilization.hpp>
+#include <GfxAccess.hpp>
+#include <GfxOff.hpp>
 #include <HWLibs.hpp>
+#include <HangWatchdog.hpp>
 #include <Headers/kern_mach.hpp>
 #include <Headers/kern_patcher.hpp>
 #include <Headers/kern_util.hpp>
+#include <IOKit/IOLocks.h>
 #include <Kexts.hpp>
 #include <NRed.hpp>
+#include <PenguinWizardry/CRC32C.hpp>
 #include <PenguinWizardry/KernelVersion.hpp>
 #include <PenguinWizardry/PatcherPlus.hpp>
+#include <PenguinWizardry/Stats.hpp>
+#include <PenguinWizardry/Uptime.hpp>
+#include <PenguinWizardry/Wait.hpp>
+#include <PerfCounters.hpp>
 #include <Regs/SDMA0.hpp>
 #include <Regs/SMU.hpp>
+#include <SDMAQueue.hpp>
+#include <SMUColdBoot.hpp>
+#include <SMUMetrics.hpp>
+#include <SMUQueue.hpp>
 #include <kern/assert.h>
+#include <kern/thread_call.h>
 #include <libkern/OSTypes.h>
 #include <libkern/c++/OSBoolean.h>
+#include <libkern/c++/OSDictionary.h>
 #include <mach/i386/vm_types.h>
 #include <mach/kern_return.h>
 
-static const char ativvaxy_rv_dat[] = {
+static constexpr char ativvaxy_rv_dat[] = {
 #embed "Firmware/ativvaxy_rv.dat"
 };
-static const char ativvaxy_nv_dat[] = {
+static constexpr char ativvaxy_nv_dat[] = {
 #embed "Firmware/ativvaxy_nv.dat"
 };
-static const char atidmcub_rn_dat[] = {
+static constexpr char atidmcub_rn_dat[] = {
 #embed "Firmware/atidmcub_rn.dat"
 };
 
-static const char _dmcu_eram_dcn10_abm_2_1[] = {
+static constexpr char _dmcu_eram_dcn10_abm_2_1[] = {
 #embed "Firmware/dmcu_eram_dcn10_abm_2_1.bin"
 };
 DMCU_FW_CONSTANT(0x100, dmcu_eram_dcn10_abm_2_1);
-static const char _dmcu_eram_dcn10_abm_2_2[] = {
+static constexpr char _dmcu_eram_dcn10_abm_2_2[] = {
 #embed "Firmware/dmcu_eram_dcn10_abm_2_2.bin"
 };
 DMCU_FW_CONSTANT(0x100, dmcu_eram_dcn10_abm_2_2);
-static const char _dmcu_eram_dcn10_abm_2_3[] = {
+static constexpr char _dmcu_eram_dcn10_abm_2_3[] = {
 #embed "Firmware/dmcu_eram_dcn10_abm_2_3.bin"
 };
 DMCU_FW_CONSTANT(0x100, dmcu_eram_dcn10_abm_2_3);
-static const char _dmcu_eram_dcn21_abm_2_1[] = {
+static constexpr char _dmcu_eram_dcn21_abm_2_1[] = {
 #embed "Firmware/dmcu_eram_dcn21_abm_2_1.bin"
 };
 DMCU_FW_CONSTANT(0x100, dmcu_eram_dcn21_abm_2_1);
-static const char _dmcu_eram_dcn21_abm_2_2[] = {
+static constexpr char _dmcu_eram_dcn21_abm_2_2[] = {
 #embed "Firmware/dmcu_eram_dcn21_abm_2_2.bin"
 };
 DMCU_FW_CONSTANT(0x100, dmcu_eram_dcn21_abm_2_2);
-static const char _dmcu_eram_dcn21_abm_2_3[] = {
+static constexpr char _dmcu_eram_dcn21_abm_2_3[] = {
 #embed "Firmware/dmcu_eram_dcn21_abm_2_3.bin"
 };
 DMCU_FW_CONSTANT(0x100, dmcu_eram_dcn21_abm_2_3);
-static const char _dmcu_eram_dcn21_abm_2_4[] = {
+static constexpr char _dmcu_eram_dcn21_abm_2_4[] = {
 #embed "Firmware/dmcu_eram_dcn21_abm_2_4.bin"
 };
 DMCU_FW_CONSTANT(0x100, dmcu_eram_dcn21_abm_2_4);
-static const char _dmcu_intvectors_dcn10_abm_2_1[] = {
+static constexpr char _dmcu_intvectors_dcn10_abm_2_1[] = {
 #embed "Firmware/dmcu_intvectors_dcn10_abm_2_1.bin"
 };
 DMCU_FW_CONSTANT(0xFFE0, dmcu_intvectors_dcn10_abm_2_1);
-static const char _dmcu_intvectors_dcn10_abm_2_2[] = {
+static constexpr char _dmcu_intvectors_dcn10_abm_2_2[] = {
 #embed "Firmware/dmcu_intvectors_dcn10_abm_2_2.bin"
 };
 DMCU_FW_CONSTANT(0xFFE0, dmcu_intvectors_dcn10_abm_2_2);
-static const char _dmcu_intvectors_dcn10_abm_2_3[] = {
+static constexpr char _dmcu_intvectors_dcn10_abm_2_3[] = {
 #embed "Firmware/dmcu_intvectors_dcn10_abm_2_3.bin"
 };
 DMCU_FW_CONSTANT(0xFFE0, dmcu_intvectors_dcn10_abm_2_3);
-static const char _dmcu_intvectors_dcn21_abm_2_1[] = {
+static constexpr char _dmcu_intvectors_dcn21_abm_2_1[] = {
 #embed "Firmware/dmcu_intvectors_dcn21_abm_2_1.bin"
 };
 DMCU_FW_CONSTANT(0xFFE0, dmcu_intvectors_dcn21_abm_2_1);
-static const char _dmcu_intvectors_dcn21_abm_2_2[] = {
+static constexpr char _dmcu_intvectors_dcn21_abm_2_2[] = {
 #embed "Firmware/dmcu_intvectors_dcn21_abm_2_2.bin"
 };
 DMCU_FW_CONSTANT(0xFFE0, dmcu_intvectors_dcn21_abm_2_2);
-static const char _dmcu_intvectors_dcn21_abm_2_3[] = {
+static constexpr char _dmcu_intvectors_dcn21_abm_2_3[] = {
 #embed "Firmware/dmcu_intvectors_dcn21_abm_2_3.bin"
 };
 DMCU_FW_CONSTANT(0xFFE0, dmcu_intvectors_dcn21_abm_2_3);
-static const char _dmcu_intvectors_dcn21_abm_2_4[] = {
+static constexpr char _dmcu_intvectors_dcn21_abm_2_4[] = {
 #embed "Firmware/dmcu_intvectors_dcn21_abm_2_4.bin"
 };
 DMCU_FW_CONSTANT(0xFFE0, dmcu_intvectors_dcn21_abm_2_4);
 
-static const char _gc_9_1_ce_ucode[] = {
+static constexpr char _gc_9_1_ce_ucode[] = {
 #embed "Firmware/gc_9_1_ce_ucode.bin"
 };
-GC_FW_CONSTANT("#80", 0x36, 0x800, 0x60, 0x1, 0x0, gc_9_1_ce_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_1_me_ucode[] = {
+GC_FW_CONSTANT(0x36, 0x800, 0x60, 0x1, 0x0, gc_9_1_ce_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_1_me_ucode[] = {
 #embed "Firmware/gc_9_1_me_ucode.bin"
 };
-GC_FW_CONSTANT("#167", 0x36, 0x1000, 0x60, 0x1, 0x0, gc_9_1_me_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_1_mec_jt_ucode[] = {
+GC_FW_CONSTANT(0x36, 0x1000, 0x60, 0x1, 0x0, gc_9_1_me_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_1_mec_jt_ucode[] = {
 #embed "Firmware/gc_9_1_mec_jt_ucode.bin"
 };
-GC_FW_CONSTANT("#480", 0x36, 0x10000, 0x0, 0x1, 0x0, gc_9_1_mec_jt_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_1_mec_ucode[] = {
+GC_FW_CONSTANT(0x36, 0x10000, 0x0, 0x1, 0x0, gc_9_1_mec_jt_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_1_mec_ucode[] = {
 #embed "Firmware/gc_9_1_mec_ucode.bin"
 };
-GC_FW_CONSTANT("#480", 0x36, 0x0, 0x0, 0x0, 0x0, gc_9_1_mec_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_1_pfp_ucode[] = {
+GC_FW_CONSTANT(0x36, 0x0, 0x0, 0x0, 0x0, gc_9_1_mec_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_1_pfp_ucode[] = {
 #embed "Firmware/gc_9_1_pfp_ucode.bin"
 };
-GC_FW_CONSTANT("#196", 0x36, 0x1400, 0x60, 0x1, 0x0, gc_9_1_pfp_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_1_rlc_srlist_cntl[] = {
+GC_FW_CONSTANT(0x36, 0x1400, 0x60, 0x1, 0x0, gc_9_1_pfp_ucode, 0x0, 0x0, 0x0, 0x0);
+// The RLC save/restore lists carry no version in their header, CAIL has always been given `#1` for them.
+static constexpr char _gc_9_1_rlc_srlist_cntl[] = {
 #embed "Firmware/gc_9_1_rlc_srlist_cntl.bin"
 };
-GC_FW_CONSTANT("#1", 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_1_rlc_srlist_cntl, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_1_rlc_srlist_gpm_mem[] = {
+GC_FW_CONSTANT_V(1, 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_1_rlc_srlist_cntl, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_1_rlc_srlist_gpm_mem[] = {
 #embed "Firmware/gc_9_1_rlc_srlist_gpm_mem.bin"
 };
-GC_FW_CONSTANT("#1", 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_1_rlc_srlist_gpm_mem, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_1_rlc_srlist_srm_mem[] = {
+GC_FW_CONSTANT_V(1, 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_1_rlc_srlist_gpm_mem, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_1_rlc_srlist_srm_mem[] = {
 #embed "Firmware/gc_9_1_rlc_srlist_srm_mem.bin"
 };
-GC_FW_CONSTANT("#1", 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_1_rlc_srlist_srm_mem, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_1_rlc_ucode[] = {
+GC_FW_CONSTANT_V(1, 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_1_rlc_srlist_srm_mem, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_1_rlc_ucode[] = {
 #embed "Firmware/gc_9_1_rlc_ucode.bin"
 };
-GC_FW_CONSTANT("#110", 0x1, 0x1000, 0x0, 0x1, 0x0, gc_9_1_rlc_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_1_rlc_ucode_a0[] = {
+GC_FW_CONSTANT(0x1, 0x1000, 0x0, 0x1, 0x0, gc_9_1_rlc_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_1_rlc_ucode_a0[] = {
 #embed "Firmware/gc_9_1_rlc_ucode_a0.bin"
 };
-GC_FW_CONSTANT("#568", 0x1, 0x1000, 0x0, 0x1, 0x0, gc_9_1_rlc_ucode_a0, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_1_rlcv_ucode[] = {
+GC_FW_CONSTANT(0x1, 0x1000, 0x0, 0x1, 0x0, gc_9_1_rlc_ucode_a0, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_1_rlcv_ucode[] = {
 #embed "Firmware/gc_9_1_rlcv_ucode.bin"
 };
-GC_FW_CONSTANT("#28", 0x1, 0x800, 0x0, 0x1, 0x0, gc_9_1_rlcv_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_2_ce_ucode[] = {
+GC_FW_CONSTANT(0x1, 0x800, 0x0, 0x1, 0x0, gc_9_1_rlcv_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_2_ce_ucode[] = {
 #embed "Firmware/gc_9_2_ce_ucode.bin"
 };
-GC_FW_CONSTANT("#80", 0x35, 0x800, 0x60, 0x1, 0x0, gc_9_2_ce_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_2_me_ucode[] = {
+GC_FW_CONSTANT(0x35, 0x800, 0x60, 0x1, 0x0, gc_9_2_ce_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_2_me_ucode[] = {
 #embed "Firmware/gc_9_2_me_ucode.bin"
 };
-GC_FW_CONSTANT("#166", 0x35, 0x1000, 0x60, 0x1, 0x0, gc_9_2_me_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_2_mec_jt_ucode[] = {
+GC_FW_CONSTANT(0x35, 0x1000, 0x60, 0x1, 0x0, gc_9_2_me_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_2_mec_jt_ucode[] = {
 #embed "Firmware/gc_9_2_mec_jt_ucode.bin"
 };
-GC_FW_CONSTANT("#480", 0x36, 0x0, 0x0, 0x1, 0x0, gc_9_2_mec_jt_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_2_mec_ucode[] = {
+GC_FW_CONSTANT(0x36, 0x0, 0x0, 0x1, 0x0, gc_9_2_mec_jt_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_2_mec_ucode[] = {
 #embed "Firmware/gc_9_2_mec_ucode.bin"
 };
-GC_FW_CONSTANT("#480", 0x36, 0x0, 0x0, 0x0, 0x0, gc_9_2_mec_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_2_pfp_ucode[] = {
+GC_FW_CONSTANT(0x36, 0x0, 0x0, 0x0, 0x0, gc_9_2_mec_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_2_pfp_ucode[] = {
 #embed "Firmware/gc_9_2_pfp_ucode.bin"
 };
-GC_FW_CONSTANT("#196", 0x36, 0x1400, 0x60, 0x1, 0x0, gc_9_2_pfp_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_2_rlc_srlist_cntl[] = {
+GC_FW_CONSTANT(0x36, 0x1400, 0x60, 0x1, 0x0, gc_9_2_pfp_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_2_rlc_srlist_cntl[] = {
 #embed "Firmware/gc_9_2_rlc_srlist_cntl.bin"
 };
-GC_FW_CONSTANT("#1", 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_2_rlc_srlist_cntl, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_2_rlc_srlist_gpm_mem[] = {
+GC_FW_CONSTANT_V(1, 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_2_rlc_srlist_cntl, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_2_rlc_srlist_gpm_mem[] = {
 #embed "Firmware/gc_9_2_rlc_srlist_gpm_mem.bin"
 };
-GC_FW_CONSTANT("#1", 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_2_rlc_srlist_gpm_mem, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_2_rlc_srlist_srm_mem[] = {
+GC_FW_CONSTANT_V(1, 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_2_rlc_srlist_gpm_mem, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_2_rlc_srlist_srm_mem[] = {
 #embed "Firmware/gc_9_2_rlc_srlist_srm_mem.bin"
 };
-GC_FW_CONSTANT("#1", 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_2_rlc_srlist_srm_mem, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_2_rlc_ucode[] = {
+GC_FW_CONSTANT_V(1, 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_2_rlc_srlist_srm_mem, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_2_rlc_ucode[] = {
 #embed "Firmware/gc_9_2_rlc_ucode.bin"
 };
-GC_FW_CONSTANT("#73", 0x1, 0x1000, 0x0, 0x1, 0x0, gc_9_2_rlc_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_2_rlcv_ucode[] = {
+GC_FW_CONSTANT(0x1, 0x1000, 0x0, 0x1, 0x0, gc_9_2_rlc_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_2_rlcv_ucode[] = {
 #embed "Firmware/gc_9_2_rlcv_ucode.bin"
 };
-GC_FW_CONSTANT("#28", 0x1, 0x800, 0x0, 0x1, 0x0, gc_9_2_rlcv_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_3_ce_ucode[] = {
+GC_FW_CONSTANT(0x1, 0x800, 0x0, 0x1, 0x0, gc_9_2_rlcv_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_3_ce_ucode[] = {
 #embed "Firmware/gc_9_3_ce_ucode.bin"
 };
-GC_FW_CONSTANT("#80", 0x36, 0x800, 0x60, 0x1, 0x0, gc_9_3_ce_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_3_me_ucode[] = {
+GC_FW_CONSTANT(0x36, 0x800, 0x60, 0x1, 0x0, gc_9_3_ce_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_3_me_ucode[] = {
 #embed "Firmware/gc_9_3_me_ucode.bin"
 };
-GC_FW_CONSTANT("#167", 0x36, 0x1000, 0x60, 0x1, 0x0, gc_9_3_me_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_3_mec_jt_ucode[] = {
+GC_FW_CONSTANT(0x36, 0x1000, 0x60, 0x1, 0x0, gc_9_3_me_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_3_mec_jt_ucode[] = {
 #embed "Firmware/gc_9_3_mec_jt_ucode.bin"
 };
-GC_FW_CONSTANT("#480", 0x36, 0x10000, 0x0, 0x1, 0x0, gc_9_3_mec_jt_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_3_mec_ucode[] = {
+GC_FW_CONSTANT(0x36, 0x10000, 0x0, 0x1, 0x0, gc_9_3_mec_jt_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_3_mec_ucode[] = {
 #embed "Firmware/gc_9_3_mec_ucode.bin"
 };
-GC_FW_CONSTANT("#480", 0x36, 0x0, 0x0, 0x0, 0x0, gc_9_3_mec_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_3_pfp_ucode[] = {
+GC_FW_CONSTANT(0x36, 0x0, 0x0, 0x0, 0x0, gc_9_3_mec_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_3_pfp_ucode[] = {
 #embed "Firmware/gc_9_3_pfp_ucode.bin"
 };
-GC_FW_CONSTANT("#196", 0x36, 0x1400, 0x60, 0x1, 0x0, gc_9_3_pfp_ucode, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_3_rlc_srlist_cntl[] = {
+GC_FW_CONSTANT(0x36, 0x1400, 0x60, 0x1, 0x0, gc_9_3_pfp_ucode, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_3_rlc_srlist_cntl[] = {
 #embed "Firmware/gc_9_3_rlc_srlist_cntl.bin"
 };
-GC_FW_CONSTANT("#1", 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_3_rlc_srlist_cntl, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_3_rlc_srlist_gpm_mem[] = {
+GC_FW_CONSTANT_V(1, 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_3_rlc_srlist_cntl, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_3_rlc_srlist_gpm_mem[] = {
 #embed "Firmware/gc_9_3_rlc_srlist_gpm_mem.bin"
 };
-GC_FW_CONSTANT("#1", 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_3_rlc_srlist_gpm_mem, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_3_rlc_srlist_srm_mem[] = {
+GC_FW_CONSTANT_V(1, 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_3_rlc_srlist_gpm_mem, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_3_rlc_srlist_srm_mem[] = {
 #embed "Firmware/gc_9_3_rlc_srlist_srm_mem.bin"
 };
-GC_FW_CONSTANT("#1", 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_3_rlc_srlist_srm_mem, 0x0, 0x0, 0x0, 0x0);
-static const char _gc_9_3_rlc_ucode[] = {
+GC_FW_CONSTANT_V(1, 0x1, 0x0, 0x0, 0x1, 0x0, gc_9_3_rlc_srlist_srm_mem, 0x0, 0x0, 0x0, 0x0);
+static constexpr char _gc_9_3_rlc_ucode[] = {
 #embed "Firmware/gc_9_3_rlc_ucode.bin"
 };
-GC_FW_CONSTANT("#60", 0x1, 0x1000, 0x0, 0x1, 0x0, gc_9_3_rlc_ucode, 0x0, 0x0, 0x0, 0x0);
+GC_FW_CONSTANT(0x1, 0x1000, 0x0, 0x1, 0x0, gc_9_3_rlc_ucode, 0x0, 0x0, 0x0, 0x0);
 
-static const char psp_asd_bin[] = {
+static constexpr char psp_asd_bin[] = {
 #embed "Firmware/psp_asd.bin"
 };
-static const char psp_auc_bin[] = {
+static constexpr char psp_auc_bin[] = {
 #embed "Firmware/psp_auc.bin"
 };
-static const char psp_dtm_bin[] = {
+static constexpr char psp_dtm_bin[] = {
 #embed "Firmware/psp_dtm.bin"
 };
-static const char psp_fp_bin[] = {
+static constexpr char psp_fp_bin[] = {
 #embed "Firmware/psp_fp.bin"
 };
-static const char psp_hdcp_bin[] = {
+static constexpr char psp_hdcp_bin[] = {
 #embed "Firmware/psp_hdcp.bin"
 };
 
-static const char _sdma_4_1_ucode[] = {
+// Trusted applications which can be skipped through the `NRedSkipTA` boot argument.
+static constexpr UInt32 kPSPSkipTADTM  = getBit(0);
+static constexpr UInt32 kPSPSkipTAHDCP = getBit(1);
+static constexpr UInt32 kPSPSkipTAAUC  = getBit(2);
+static constexpr UInt32 kPSPSkipTAFP   = getBit(3);
+static constexpr UInt32 kPSPSkipTAAll  = kPSPSkipTADTM | kPSPSkipTAHDCP | kPSPSkipTAAUC | kPSPSkipTAFP;
+
+static constexpr char _sdma_4_1_ucode[] = {
 #embed "Firmware/sdma_4_1_ucode.bin"
 };
-SDMA_FW_CONSTANT("40", sdma_4_1_ucode, 0x29, 0x0, 0x0);
+SDMA_FW_CONSTANT(sdma_4_1_ucode, 0x29, 0x0, 0x0);
+
+// The CAIL checksum fields are all zero, so a corrupted image would otherwise only show up as a GPU hang.
+// Digests are pinned to the images in the tree, and the build fails if one of them changes without its digest. At
+// runtime, the images of the detected ASIC are checked in the background as soon as the device ID is known, everything
+// else the first time it is handed over. A mismatch fails the hand-off with a CAIL error.
+static constexpr UInt8 kFirmwareRaven  = getBit(0);
+static constexpr UInt8 kFirmwareRenoir = getBit(1);
+static constexpr UInt8 kFirmwareAll    = kFirmwareRaven | kFirmwareRenoir;
+
+struct EmbeddedFirmwareDigest
+{
+    const char* name;
+    const void* data;
+    size_t      size;
+    UInt32      crc;
+    UInt8       families;
+};
+
+static UInt32 firmwareDigestMismatch() { return 0; }
+
+// Not a constant expression when the image doesn't match, which is what fails the build.
+template<const size_t N>
+static consteval UInt32 pinnedDigest(const char (&data)[N], const UInt32 expected)
+{ return PenguinWizardry::crc32c(data) == expected ? expected : firmwareDigestMismatch(); }
+
+#define FW_DIGEST(_D, _C, _F) {#_D, _D, sizeof(_D), pinnedDigest(_D, _C), (_F)}
+
+static constexpr EmbeddedFirmwareDigest firmwareDigests[] = {
+    FW_DIGEST(ativvaxy_rv_dat, 0x876A8039, kFirmwareAll),
+    FW_DIGEST(ativvaxy_nv_dat, 0x7A70A8B3, kFirmwareAll),
+    FW_DIGEST(atidmcub_rn_dat, 0x37340F3C, kFirmwareAll),
+    FW_DIGEST(_dmcu_eram_dcn10_abm_2_1, 0x0A6B6E59, kFirmwareRaven),
+    FW_DIGEST(_dmcu_eram_dcn10_abm_2_2, 0xB38F80D9, kFirmwareRaven),
+    FW_DIGEST(_dmcu_eram_dcn10_abm_2_3, 0x699032F7, kFirmwareRaven),
+    FW_DIGEST(_dmcu_eram_dcn21_abm_2_1, 0xCF56060F, kFirmwareRenoir),
+    FW_DIGEST(_dmcu_eram_dcn21_abm_2_2, 0xB7DE4DAB, kFirmwareRenoir),
+    FW_DIGEST(_dmcu_eram_dcn21_abm_2_3, 0x2A398F82, kFirmwareRenoir),
+    FW_DIGEST(_dmcu_eram_dcn21_abm_2_4, 0x15B5DD9A, kFirmwareRenoir),
+    FW_DIGEST(_dmcu_intvectors_dcn10_abm_2_1, 0x44854C7C, kFirmwareRaven),
+    FW_DIGEST(_dmcu_intvectors_dcn10_abm_2_2, 0x8B29F678, kFirmwareRaven),
+    FW_DIGEST(_dmcu_intvectors_dcn10_abm_2_3, 0xF0BF9F47, kFirmwareRaven),
+    FW_DIGEST(_dmcu_intvectors_dcn21_abm_2_1, 0xA41D6499, kFirmwareRenoir),
+    FW_DIGEST(_dmcu_intvectors_dcn21_abm_2_2, 0xE8DC12E8, kFirmwareRenoir),
+    FW_DIGEST(_dmcu_intvectors_dcn21_abm_2_3, 0x321C5F57, kFirmwareRenoir),
+    FW_DIGEST(_dmcu_intvectors_dcn21_abm_2_4, 0x0DEE007E, kFirmwareRenoir),
+    FW_DIGEST(_gc_9_1_ce_ucode, 0xAE50A73E, kFirmwareRaven),
+    FW_DIGEST(_gc_9_1_me_ucode, 0x5226FF89, kFirmwareRaven),
+    FW_DIGEST(_gc_9_1_mec_jt_ucode, 0x5EDCDC58, kFirmwareRaven),
+    FW_DIGEST(_gc_9_1_mec_ucode, 0xA136ABBC, kFirmwareRaven),
+    FW_DIGEST(_gc_9_1_pfp_ucode, 0xDF664BC8, kFirmwareRaven),
+    FW_DIGEST(_gc_9_1_rlc_srlist_cntl, 0xC9817D5D, kFirmwareRaven),
+    FW_DIGEST(_gc_9_1_rlc_srlist_gpm_mem, 0xE2C5B918, kFirmwareRaven),
+    FW_DIGEST(_gc_9_1_rlc_srlist_srm_mem, 0x27E183C4, kFirmwareRaven),
+    FW_DIGEST(_gc_9_1_rlc_ucode, 0xE5E3FCC0, kFirmwareRaven),
+    FW_DIGEST(_gc_9_1_rlc_ucode_a0, 0x3815477C, kFirmwareRaven),
+    FW_DIGEST(_gc_9_1_rlcv_ucode, 0x588978C7, kFirmwareRaven),
+    FW_DIGEST(_gc_9_2_ce_ucode, 0x070D2373, kFirmwareRaven),
+    FW_DIGEST(_gc_9_2_me_ucode, 0x24EC6D4F, kFirmwareRaven),
+    FW_DIGEST(_gc_9_2_mec_jt_ucode, 0xD87D525A, kFirmwareRaven),
+    FW_DIGEST(_gc_9_2_mec_ucode, 0x004E78CF, kFirmwareRaven),
+    FW_DIGEST(_gc_9_2_pfp_ucode, 0xC5BEFC96, kFirmwareRaven),
+    FW_DIGEST(_gc_9_2_rlc_srlist_cntl, 0xE5E5246C, kFirmwareRaven),
+    FW_DIGEST(_gc_9_2_rlc_srlist_gpm_mem, 0x179BDF12, kFirmwareRaven),
+    FW_DIGEST(_gc_9_2_rlc_srlist_srm_mem, 0x8DAFADB1, kFirmwareRaven),
+    FW_DIGEST(_gc_9_2_rlc_ucode, 0x0D844447, kFirmwareRaven),
+    FW_DIGEST(_gc_9_2_rlcv_ucode, 0xEA352B65, kFirmwareRaven),
+    FW_DIGEST(_gc_9_3_ce_ucode, 0x00208996, kFirmwareRenoir),
+    FW_DIGEST(_gc_9_3_me_ucode, 0x27086F39, kFirmwareRenoir),
+    FW_DIGEST(_gc_9_3_mec_jt_ucode, 0xBD2706E9, kFirmwareRenoir),
+    FW_DIGEST(_gc_9_3_mec_ucode, 0x49DBB549, kFirmwareRenoir),
+    FW_DIGEST(_gc_9_3_pfp_ucode, 0xA6C76DBC, kFirmwareRenoir),
+    FW_DIGEST(_gc_9_3_rlc_srlist_cntl, 0x3F0A5973, kFirmwareRenoir),
+    FW_DIGEST(_gc_9_3_rlc_srlist_gpm_mem, 0xFABD49A4, kFirmwareRenoir),
+    FW_DIGEST(_gc_9_3_rlc_srlist_srm_mem, 0xDE5DBFF1, kFirmwareRenoir),
+    FW_DIGEST(_gc_9_3_rlc_ucode, 0x07A64657, kFirmwareRenoir),
+    FW_DIGEST(psp_asd_bin, 0x38CC2E48, kFirmwareAll),
+    FW_DIGEST(psp_auc_bin, 0xB6372635, kFirmwareAll),
+    FW_DIGEST(psp_dtm_bin, 0xF8FEA45F, kFirmwareAll),
+    FW_DIGEST(psp_fp_bin, 0x6D65CB22, kFirmwareAll),
+    FW_DIGEST(psp_hdcp_bin, 0xBF536B3F, kFirmwareAll),
+    FW_DIGEST(_sdma_4_1_ucode, 0x680E04B0, kFirmwareAll),
+};
+
+#undef FW_DIGEST
+
+static bool    firmwareVerified[arrsize(firmwareDigests)]{};    // Set with atomics, staging runs in the background.
+static IOLock* firmwareStagingLock{nullptr};
+static bool    firmwareStagingPending{false};
+static UInt64  firmwareStagingRequestedNs{0};
+
+// Staging and a hand-off may check the same image at once, which only costs a second CRC pass.
+static bool verifyFirmwareDigest(const size_t i)
+{
+    if (__atomic_load_n(&firmwareVerified[i], __ATOMIC_ACQUIRE)) { return true; }
+
+    const auto& digest = firmwareDigests[i];
+    const auto  crc    = PenguinWizardry::crc32c(digest.data, digest.size);
+    if (crc != digest.crc) {
+        SYSLOG("HWLibs", "Firmware `%s` is corrupted (CRC32C 0x%08X, expected 0x%08X)", digest.name, crc, digest.crc);
+        return false;
+    }
+    __atomic_store_n(&firmwareVerified[i], true, __ATOMIC_RELEASE);
+    return true;
+}
+
+static void firmwareStagingThread(thread_call_param_t param0, thread_call_param_t)
+{
+    const auto families = static_cast<UInt8>(reinterpret_cast<uintptr_t>(param0));
+    const auto start    = PenguinWizardry::uptimeNs();
+    size_t     bytes    = 0;
+    for (size_t i = 0; i < arrsize(firmwareDigests); i += 1) {
+        if ((firmwareDigests[i].families & families) == 0) { continue; }
+        verifyFirmwareDigest(i);
+        bytes += firmwareDigests[i].size;
+    }
+    DBGLOG("HWLibs", "Staged %zu bytes of firmware in %lluus, started %lluus after the request", bytes,
+           (PenguinWizardry::uptimeNs() - start) / 1000, (start - firmwareStagingRequestedNs) / 1000);
+
+    IOLockLock(firmwareStagingLock);
+    firmwareStagingPending = false;
+    IOLockWakeup(firmwareStagingLock, &firmwareStagingPending, false);
+    IOLockUnlock(firmwareStagingLock);
+}
+
+static void waitForFirmwareStaging()
+{
+    if (firmwareStagingLock == nullptr) { return; }
+
+    IOLockLock(firmwareStagingLock);
+    if (firmwareStagingPending) {
+        const auto start = PenguinWizardry::uptimeNs();
+        while (firmwareStagingPending) { IOLockSleep(firmwareStagingLock, &firmwareStagingPending, THREAD_UNINT); }
+        DBGLOG("HWLibs", "Waited %lluus for firmware staging, first needed %lluus after the request",
+               (PenguinWizardry::uptimeNs() - start) / 1000, (start - firmwareStagingRequestedNs) / 1000);
+    }
+    IOLockUnlock(firmwareStagingLock);
+}
+
+static bool verifyFirmware(const void* const data)
+{
+    waitForFirmwareStaging();
+    for (size_t i = 0; i < arrsize(firmwareDigests); i += 1) {
+        if (firmwareDigests[i].data == data) { return verifyFirmwareDigest(i); }
+    }
+    SYSLOG("HWLibs", "Firmware at %p has no digest", data);
+    return false;
+}
 
 static const UInt8 kDeviceTypeTablePattern[] = {0x60, 0x68, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61, 0x68, 0x00, 0x00,
                                                 0x00, 0x00, 0x00, 0x00, 0x62, 0x68, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -382,10 +555,6 @@ static const UInt8      kSdmaCgsWriteRegisterCallPatternMask[] = {0xFF, 0xFF, 0x
                                                                   0xFF, 0xFF, 0xF0, 0xFF, 0x00, 0x00, 0x00, 0x00};
 static constexpr size_t kSdmaCgsWriteRegisterCallPatternJumpInstOff = 12;
 
-static const UInt8      kSmuCosWaitForCallPattern[]          = {0xE8, 0x00, 0x00, 0x00, 0x00, 0x85, 0xC0};
-static const UInt8      kSmuCosWaitForCallPatternMask[]      = {0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF};
-static constexpr size_t kSmuCosWaitForCallPatternJumpInstOff = 0;
-
 static const UInt8      kSmuCgsWriteRegisterCallPattern[]          = {0x41, 0xB8, 0x04, 0x00, 0x00, 0x00, 0x45,
                                                                       0x31, 0xC9, 0xE8, 0x00, 0x00, 0x00, 0x00};
 static const UInt8      kSmuCgsWriteRegisterCallPatternMask[]      = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
@@ -567,12 +736,32 @@ X5000HWLibs::X5000HWLibs()
     }
 }
 
+void X5000HWLibs::stageFirmware()
+{
+    const auto families = NRed::singleton().getAttributes().isRenoir() ? kFirmwareRenoir : kFirmwareRaven;
+
+    firmwareStagingLock = IOLockAlloc();
+    PANIC_COND(firmwareStagingLock == nullptr, "HWLibs", "Failed to allocate firmware staging lock");
+    // One-shot, lives for as long as the kext does.
+    const auto call = thread_call_allocate(firmwareStagingThread,
+                                           reinterpret_cast<thread_call_param_t>(static_cast<uintptr_t>(families)));
+    PANIC_COND(call == nullptr, "HWLibs", "Failed to allocate firmware staging call");
+    firmwareStagingPending     = true;
+    firmwareStagingRequestedNs = PenguinWizardry::uptimeNs();
+    thread_call_enter(call);
+}
+
 void X5000HWLibs::processKext(KernelPatcher& patcher, const size_t id, const mach_vm_address_t slide, const size_t size)
 {
     if (kextRadeonX5000HWLibs.loadIndex != id) { return; }
 
     NRed::singleton().hwLateInit();
 
+    if (PE_parse_boot_argn("NRedSkipTA", &this->pspSkipTAMask, sizeof(this->pspSkipTAMask))) {
+        this->pspSkipTAMask &= kPSPSkipTAAll;
+        DBGLOG("HWLibs", "PSP TA skip mask = 0x%X", this->pspSkipTAMask);
+    }
+
     CAILAsicCapsEntry*     orgCapsTable       = nullptr;
     CAILAsicCapsInitEntry* orgCapsInitTable   = nullptr;
     AMDDeviceTypeEntry*    orgDeviceTypeTable = nullptr;
@@ -611,14 +800,11 @@ void X5000HWLibs::processKext(KernelPatcher& patcher, const size_t id, const mac
                "HWLibs", "Failed to solve symbols via jump pattern");
 
     KernelPatcher::SolveRequest smuRequests[] = {
-        {"_smu_cos_wait_for", this->smuCosWaitFor},
         {"_smu_cgs_write_register", this->smuCgsWriteRegister},
         {"_smu_cgs_read_register", this->smuCgsReadRegister},
     };
     if (!patcher.solveMultiple(id, smuRequests, slide, size, true)) {
         PenguinWizardry::JumpPatternSolveRequest smuPatternRequests[] = {
-            {nullptr, this->smuCosWaitFor, kSmuCosWaitForCallPattern, kSmuCosWaitForCallPatternMask,
-             kSmuCosWaitForCallPatternJumpInstOff},
             {nullptr, this->smuCgsWriteRegister, kSmuCgsWriteRegisterCallPattern, kSmuCgsWriteRegisterCallPatternMask,
              kSmuCgsWriteRegisterCallPatternJumpInstOff},
             {nullptr, this->smuCgsReadRegister, kSmuCgsReadRegisterCallPattern, kSmuCgsReadRegisterCallPatternMask,
@@ -627,9 +813,19 @@ void X5000HWLibs::processKext(KernelPatcher& patcher, const size_t id, const mac
         PANIC_COND(!PenguinWizardry::JumpPatternSolveRequest::solveAll(
                        patcher, id, smuPatternRequests,
                        reinterpret_cast<mach_vm_address_t>(this->smu90SendMessageWithParameter), PAGE_SIZE),
-                   "HWLibs", "Failed to solve SMU COS/CGS functions");
+                   "HWLibs", "Failed to solve SMU CGS functions");
     }
 
+    SMUQueue::singleton().init(smuMailboxSend);
+    DPMBoost::singleton().init();
+    SMUMetrics::singleton().init();
+    GPUUtilization::singleton().init();
+    HangWatchdog::singleton().init();
+    PerfCounters::singleton().init();
+    GfxOff::singleton().init();
+    ClockGating::singleton().init();
+    SDMAQueue::singleton().init();
+
     if (currentKernelVersion() <= MACOS_10_15_X) {
         PenguinWizardry::PatternRouteRequest request{"__ZN16AmdTtlFwServices7getIpFwEjPKcP10_TtlFwInfo", wrapGetIpFw,
                                                      this->orgGetIpFw};
@@ -779,10 +975,10 @@ void X5000HWLibs::processKext(KernelPatcher& patcher, const size_t id, const mac
             orgDevCapTable->revision     = DEVICE_CAP_ENTRY_REV_DONT_CARE;
             orgDevCapTable->enumRevision = DEVICE_CAP_ENTRY_REV_DONT_CARE;
 
-            orgDevCapTable->asicGoldenSettings->goldenSettings =
-                NRed::singleton().getAttributes().isRaven2() ? goldenSettingsRaven2 :
-                NRed::singleton().getAttributes().isRenoir() ? goldenSettingsRenoir :
-                                                               goldenSettingsRaven;
+            this->goldenSettings = NRed::singleton().getAttributes().isRaven2() ? goldenSettingsRaven2 :
+                                   NRed::singleton().getAttributes().isRenoir() ? goldenSettingsRenoir :
+                                                                                  goldenSettingsRaven;
+            orgDevCapTable->asicGoldenSettings->goldenSettings = this->goldenSettings;
 
             break;
         }
@@ -869,25 +1065,33 @@ void X5000HWLibs::wrapPopulateFirmwareDirectory(void* const self)
     const auto fwDir = singleton().fwDirField(self);
     assert(fwDir != nullptr);
 
-    const auto ravenFw =
-        singleton().orgCreateFirmware(ativvaxy_rv_dat, sizeof(ativvaxy_rv_dat), 0x0100, "ativvaxy_rv.dat");
-    assert(ravenFw != nullptr);
-    singleton().orgPutFirmware(fwDir, kAMDDeviceTypeNavi10, ravenFw);
+    // A corrupted image is left out, so the IP that needs it fails to find its firmware instead of loading garbage.
+    if (verifyFirmware(ativvaxy_rv_dat)) {
+        const auto ravenFw =
+            singleton().orgCreateFirmware(ativvaxy_rv_dat, sizeof(ativvaxy_rv_dat), 0x0100, "ativvaxy_rv.dat");
+        assert(ravenFw != nullptr);
+        singleton().orgPutFirmware(fwDir, kAMDDeviceTypeNavi10, ravenFw);
+    }
 
-    const auto renoirFw =
-        singleton().orgCreateFirmware(ativvaxy_nv_dat, sizeof(ativvaxy_nv_dat), 0x0202, "ativvaxy_nv.dat");
-    assert(renoirFw != nullptr);
-    singleton().orgPutFirmware(fwDir, kAMDDeviceTypeNavi10, renoirFw);
+    if (verifyFirmware(ativvaxy_nv_dat)) {
+        const auto renoirFw =
+            singleton().orgCreateFirmware(ativvaxy_nv_dat, sizeof(ativvaxy_nv_dat), 0x0202, "ativvaxy_nv.dat");
+        assert(renoirFw != nullptr);
+        singleton().orgPutFirmware(fwDir, kAMDDeviceTypeNavi10, renoirFw);
+    }
 
-    const auto dmcubFw =
-        singleton().orgCreateFirmware(atidmcub_rn_dat, sizeof(atidmcub_rn_dat), 0x0201, "atidmcub_0.dat");
-    assert(dmcubFw != nullptr);
-    singleton().orgPutFirmware(fwDir, kAMDDeviceTypeNavi10, dmcubFw);
+    if (verifyFirmware(atidmcub_rn_dat)) {
+        const auto dmcubFw =
+            singleton().orgCreateFirmware(atidmcub_rn_dat, sizeof(atidmcub_rn_dat), 0x0201, "atidmcub_0.dat");
+        assert(dmcubFw != nullptr);
+        singleton().orgPutFirmware(fwDir, kAMDDeviceTypeNavi10, dmcubFw);
+    }
 }
 
 template<const UInt32 N>
 static bool setIpFwOutForFW(const char (&data)[N], void* const out)
 {
+    if (!verifyFirmware(data)) { return false; }
     getMember<const void*>(out, 0x0) = data;
     getMember<UInt32>(out, 0x8)      = N;
     return true;
@@ -954,10 +1158,26 @@ CAILResult X5000HWLibs::pspSecurityFeatureCapsSet12(void* const ctx)
 }
 
 template<const UInt32 N>
-static UInt32 replacePspCmdDataWith(void* const data, const char (&fw)[N])
+static bool replacePspCmdDataWith(void* const data, UInt32& dataSize, const char (&fw)[N])
 {
+    if (!verifyFirmware(fw)) { return false; }
     memcpy(data, fw, N);
-    return N;
+    dataSize = N;
+    return true;
+}
+
+static bool shouldSkipPspTA(const UInt32 mask, const UInt32 bit, const char* const name)
+{
+    if ((mask & bit) == 0) { return false; }
+    DBGLOG("HWLibs", "Skipping %s TA load", name);
+    return true;
+}
+
+// Answers like the PSP would for a TA it can't load, so CAIL doesn't pick up the session of an earlier response.
+static CAILResult skipPspTA(void* const outResponse)
+{
+    if (outResponse != nullptr) { *static_cast<AMDPSPResponse*>(outResponse) = {.status = kPSPStatusNotSupported}; }
+    return kCAILResultUnsupported;
 }
 
 CAILResult X5000HWLibs::wrapPspCmdKmSubmit(void* const ctx, void* const cmd, void* const outData,
@@ -969,20 +1189,28 @@ CAILResult X5000HWLibs::wrapPspCmdKmSubmit(void* const ctx, void* const cmd, voi
 
     switch (pspCmd) {
         case kPSPCommandLoadTA: {
-            const char* name = reinterpret_cast<char*>(data + 0x8DB);
-            if (strncmp(name, "AMD DTM Application", 19) == 0) { dataSize = replacePspCmdDataWith(data, psp_dtm_bin); }
+            // The TA is never submitted to the PSP when skipped, CAIL treats it as unsupported.
+            const auto  skipMask = singleton().pspSkipTAMask;
+            const char* name     = reinterpret_cast<char*>(data + 0x8DB);
+            if (strncmp(name, "AMD DTM Application", 19) == 0) {
+                if (shouldSkipPspTA(skipMask, kPSPSkipTADTM, "DTM")) { return skipPspTA(outResponse); }
+                if (!replacePspCmdDataWith(data, dataSize, psp_dtm_bin)) { return kCAILResultFailed; }
+            }
             else if (strncmp(name, "AMD HDCP Application", 20) == 0) {
-                dataSize = replacePspCmdDataWith(data, psp_hdcp_bin);
+                if (shouldSkipPspTA(skipMask, kPSPSkipTAHDCP, "HDCP")) { return skipPspTA(outResponse); }
+                if (!replacePspCmdDataWith(data, dataSize, psp_hdcp_bin)) { return kCAILResultFailed; }
             }
             else if (strncmp(name, "AMD AUC Application", 19) == 0) {
-                dataSize = replacePspCmdDataWith(data, psp_auc_bin);
+                if (shouldSkipPspTA(skipMask, kPSPSkipTAAUC, "AUC")) { return skipPspTA(outResponse); }
+                if (!replacePspCmdDataWith(data, dataSize, psp_auc_bin)) { return kCAILResultFailed; }
             }
             else if (strncmp(name, "AMD FP Application", 18) == 0) {
-                dataSize = replacePspCmdDataWith(data, psp_fp_bin);
+                if (shouldSkipPspTA(skipMask, kPSPSkipTAFP, "FP")) { return skipPspTA(outResponse); }
+                if (!replacePspCmdDataWith(data, dataSize, psp_fp_bin)) { return kCAILResultFailed; }
             }
         } break;
         case kPSPCommandLoadASD: {
-            dataSize = replacePspCmdDataWith(data, psp_asd_bin);
+            if (!replacePspCmdDataWith(data, dataSize, psp_asd_bin)) { return kCAILResultFailed; }
         } break;
         default: {
         } break;
@@ -991,22 +1219,163 @@ CAILResult X5000HWLibs::wrapPspCmdKmSubmit(void* const ctx, void* const cmd, voi
     return FunctionCast(wrapPspCmdKmSubmit, singleton().orgPspCmdKmSubmit)(ctx, cmd, outData, outResponse);
 }
 
+CAILResult X5000HWLibs::smuMailboxSend(void* const ctx, const UInt32 message, const UInt32 param,
+                                       UInt32* const outParam)
+{
+    if (const auto res = singleton().smu90SendMessageWithParameter(ctx, message, param); res != kCAILResultOK) {
+        return res;
+    }
+
+    if (outParam != nullptr) {
+        *outParam = singleton().smuCgsReadRegister(ctx, MP1_SMN_C2PMSG_82, 0, kCAILHWBlockMP1, 0);
+    }
+
+    return kCAILResultOK;
+}
+
 CAILResult X5000HWLibs::smuSendMessage(void* const ctx, const UInt32 message, const UInt32 param,
                                        UInt32* const outParam) const
+{ return SMUQueue::singleton().send(ctx, message, param, outParam); }
+
+static UInt32 goldenRegisterBase(const CAILHWBlock block, const UInt32 segment)
 {
-    if (const auto res = this->smu90SendMessageWithParameter(ctx, message, param); res != kCAILResultOK) { return res; }
+    switch (block) {
+        case kCAILHWBlockGC   : return segment == 0 ? GC_BASE_0 : GC_BASE_1;
+        case kCAILHWBlockSDMA0: return SDMA0_BASE_0;
+        default               : return 0;
+    }
+}
 
-    if (outParam != nullptr) { *outParam = this->smuCgsReadRegister(ctx, MP1_SMN_C2PMSG_82, 0, kCAILHWBlockMP1, 0); }
+// CAIL programs the golden settings early in HW init, so by the time the accelerator is up they should all still hold.
+void X5000HWLibs::verifyGoldenSettings() const
+{
+    if (this->goldenSettings == nullptr || !checkKernelArgument("-NRedGoldenVerify")) { return; }
+
+    auto* const mismatches = OSDictionary::withCapacity(0);
+    if (mismatches == nullptr) { return; }
+
+    const auto&       nred = NRed::singleton();
+    const GfxOffGuard gfxOffGuard;
+    UInt32            checked = 0;
+    char              key[16];
+    for (const auto* ip = this->goldenSettings; ip->entries != nullptr; ip += 1) {
+        for (const auto* reg = ip->entries; reg->regOffset != 0xFFFFFFFF; reg += 1) {
+            const auto base = goldenRegisterBase(ip->hwBlock, reg->segment);
+            if (base == 0) { continue; }
+
+            const auto addr     = base + reg->regOffset;
+            const auto value    = nred.readReg32(addr);
+            const auto expected = reg->orMask & reg->andMask;
+            checked += 1;
+            if ((value & reg->andMask) == expected) { continue; }
+
+            SYSLOG("HWLibs", "Golden register 0x%X is 0x%X, expected 0x%X under mask 0x%X", addr, value, expected,
+                   reg->andMask);
+            snprintf(key, arrsize(key), "0x%X", addr);
+            PenguinWizardry::setStatsNumber(mismatches, key, value);
+        }
+    }
+    SYSLOG("HWLibs", "%u out of %u golden registers do not match", mismatches->getCount(), checked);
+    nred.setProp("NRedGoldenMismatches", mismatches);
+    mismatches->release();
+}
 
-    return kCAILResultOK;
+// Published as `NRedSMUStats` on the iGPU after power-up and reset sequences, which is when a stall would matter.
+void X5000HWLibs::publishSMUStats() const
+{
+    auto* const messages = OSDictionary::withCapacity(SMUQueue::MESSAGE_COUNT);
+    if (messages == nullptr) { return; }
+
+    const auto& queue = SMUQueue::singleton();
+    char        key[8];
+    for (UInt32 message = 0; message < SMUQueue::MESSAGE_COUNT; message += 1) {
+        const auto& histogram = queue.getMessageLatency(message);
+        if (histogram.getCount() == 0) { continue; }
+
+        auto* const dict = histogram.copyDictionary();
+        if (dict == nullptr) { continue; }
+        PenguinWizardry::setStatsNumber(dict, "Failures", queue.getMessageFailures(message));
+        snprintf(key, arrsize(key), "0x%02X", message);
+        PenguinWizardry::setStatsObject(messages, key, dict);
+    }
+
+    auto* const stats = OSDictionary::withCapacity(5);
+    if (stats == nullptr) {
+        messages->release();
+        return;
+    }
+    PenguinWizardry::setStatsObject(stats, "Messages", messages);
+    PenguinWizardry::setStatsObject(stats, "PowerUp", this->smuPowerUpLatency.copyDictionary());
+    PenguinWizardry::setStatsObject(stats, "FullAsicReset", this->smuFullAsicResetLatency.copyDictionary());
+    PenguinWizardry::setStatsObject(stats, "FirmwareLoad", this->smuFwLoadLatency.copyDictionary());
+    if (this->smuColdBootRecorded) {
+        auto* const coldBoot = OSDictionary::withCapacity(4);
+        if (coldBoot != nullptr) {
+            PenguinWizardry::setStatsNumber(coldBoot, "Messages", this->smuColdBootMessages);
+            PenguinWizardry::setStatsNumber(coldBoot, "MailboxUs", this->smuColdBootMailboxUs);
+            PenguinWizardry::setStatsNumber(coldBoot, "TotalUs", this->smuColdBootUs);
+            PenguinWizardry::setStatsNumber(coldBoot, "PowerUpReplayUs", this->smuColdBootReplayUs);
+        }
+        PenguinWizardry::setStatsObject(stats, "ColdBoot", coldBoot);
+    }
+    NRed::singleton().setProp("NRedSMUStats", stats);
+    stats->release();
 }
 
-CAILResult X5000HWLibs::smuPowerUpConfigCommon(void* const ctx)
+void X5000HWLibs::smuRecordSequence(PenguinWizardry::LatencyHistogram& histogram, const UInt64 startUs)
 {
-    if (const auto res = singleton().smuSendMessage(ctx, PPSMC_MSG_PowerUpSdma); res != kCAILResultOK) { return res; }
-    if (const auto res = singleton().smuSendMessage(ctx, PPSMC_MSG_PowerUpGfx); res != kCAILResultOK) { return res; }
+    histogram.record(PenguinWizardry::uptimeUs() - startUs);
+    this->publishSMUStats();
+}
 
-    return kCAILResultOK;
+// Messages are counted from SW init onwards, the wall time only covers HW init itself.
+// The power-up batch is also replayed against `SMUMailboxModel` at each message's mean latency so far, which is how
+// much of the mailbox time the batch itself accounts for.
+void X5000HWLibs::smuRecordColdBoot(const UInt64 startUs, const SMUMessage* const powerUp, const size_t powerUpCount)
+{
+    if (this->smuColdBootRecorded) { return; }
+
+    const auto& queue          = SMUQueue::singleton();
+    this->smuColdBootRecorded  = true;
+    this->smuColdBootMessages  = queue.getTotalMessages();
+    this->smuColdBootMailboxUs = queue.getTotalMailboxUs();
+    this->smuColdBootUs        = PenguinWizardry::uptimeUs() - startUs;
+
+    UInt32 latencyUs[SMUQueue::MESSAGE_COUNT];
+    for (UInt32 message = 0; message < SMUQueue::MESSAGE_COUNT; message += 1) {
+        const auto snapshot = queue.getMessageLatency(message).snapshot();
+        latencyUs[message]  = snapshot.count == 0 ? 0 : static_cast<UInt32>(snapshot.totalUs / snapshot.count);
+    }
+    SMUMailboxModel model{.latencyUs = latencyUs};
+    this->smuColdBootReplayUs = simulateSMUColdBoot(model, powerUp, powerUpCount, false).mailboxUs;
+
+    SYSLOG("HWLibs", "SMU cold boot took %lluus, %llu messages spent %lluus in the mailbox, %lluus on power-up",
+           this->smuColdBootUs, this->smuColdBootMessages, this->smuColdBootMailboxUs, this->smuColdBootReplayUs);
+    this->publishSMUStats();
+}
+
+// Has to run once GFX and SDMA are powered up, `PerfCounters` relies on `GfxOff` having been started.
+void X5000HWLibs::onSMUPoweredUp(void* const ctx, const bool hasMetricsTable)
+{
+    DPMBoost::singleton().start(ctx);
+    SMUMetrics::singleton().start(ctx, hasMetricsTable);
+    GPUUtilization::singleton().start();
+    HangWatchdog::singleton().start();
+    GfxOff::singleton().start(ctx);
+    PerfCounters::singleton().start();
+}
+
+void X5000HWLibs::onSMUPoweredDown()
+{
+    DPMBoost::singleton().stop();
+    SMUMetrics::singleton().stop();
+    GPUUtilization::singleton().stop();
+    HangWatchdog::singleton().stop();
+    SDMAQueue::singleton().stop();
+    PerfCounters::singleton().stop();
+    GfxOff::singleton().stop();
+    GfxAccessTracker::singleton().noteIdle();
+    SMUQueue::singleton().cancelAll();
 }
 
 CAILResult X5000HWLibs::smuInternalSwInit(void* const ctx, void*, AMDSMUSWInitOutput*)
@@ -1026,21 +1395,22 @@ CAILResult X5000HWLibs::smuGetUCodeConsts(void* const ctx, AMDSMUUCodeConstants*
 
 CAILResult X5000HWLibs::smu10PowerUpConfig(void* const ctx)
 {
-    if (const auto res = singleton().smuSendMessage(ctx, PPSMC_MSG_ForceGfxContentSave);
-        res != kCAILResultOK && res != kCAILResultUnsupported)
-    {
-        return res;
-    }
-    if (const auto res = smuPowerUpConfigCommon(ctx); res != kCAILResultOK) { return res; }
-    if (const auto res = singleton().smuSendMessage(ctx, PPSMC_MSG_PowerGateMmHub);
-        res != kCAILResultOK && res != kCAILResultUnsupported)
-    {
-        return res;
-    }
-    return kCAILResultOK;
+    const auto start = PenguinWizardry::uptimeUs();
+    const auto res   = SMUQueue::singleton().sendBatch(ctx, kSMU10PowerUpMessages);
+    singleton().smuRecordSequence(singleton().smuPowerUpLatency, start);
+    if (res == kCAILResultOK) { onSMUPoweredUp(ctx, false); }
+    return res;
 }
 
-CAILResult X5000HWLibs::smu10InternalHwInit(void* const ctx) { return smu10PowerUpConfig(ctx); }
+CAILResult X5000HWLibs::smu10InternalHwInit(void* const ctx)
+{
+    const auto start = PenguinWizardry::uptimeUs();
+    const auto res   = smu10PowerUpConfig(ctx);
+    if (res == kCAILResultOK) {
+        singleton().smuRecordColdBoot(start, kSMU10PowerUpMessages, arrsize(kSMU10PowerUpMessages));
+    }
+    return res;
+}
 
 bool X5000HWLibs::smu12IsFwLoaded(void* const ctx)
 {
@@ -1051,33 +1421,52 @@ bool X5000HWLibs::smu12IsFwLoaded(void* const ctx)
 
 CAILResult X5000HWLibs::smu12WaitForFwLoaded(void* const ctx)
 {
-    return singleton().smuCosWaitFor(ctx, smu12IsFwLoaded, ctx,
-                                     /*ctx->waitOnRegisterTimeout*/ PP_WAIT_ON_REGISTER_TIMEOUT_DEFAULT);
+    const auto res = PenguinWizardry::waitFor([ctx] { return smu12IsFwLoaded(ctx); },
+                                              /*ctx->waitOnRegisterTimeout*/ PP_WAIT_ON_REGISTER_TIMEOUT_DEFAULT);
+    singleton().smuFwLoadLatency.record(res.elapsedUs);
+    if (!res.satisfied) {
+        SYSLOG("HWLibs", "SMU firmware not loaded after %llums (%u polls)", res.elapsedUs / 1000, res.polls);
+        singleton().publishSMUStats();
+        return kCAILResultNoResponse;
+    }
+    DBGLOG("HWLibs", "SMU firmware loaded after %lluus (%u polls)", res.elapsedUs, res.polls);
+    return kCAILResultOK;
 }
 
 CAILResult X5000HWLibs::smu12PowerUpConfig(void* const ctx)
 {
-    if (const auto res = smuPowerUpConfigCommon(ctx); res != kCAILResultOK) { return res; }
-    if (const auto res = singleton().smuSendMessage(ctx, PPSMC_MSG_PowerGateAtHub);
-        res != kCAILResultOK && res != kCAILResultUnsupported)
-    {
-        return res;
-    }
-
-    return kCAILResultOK;
+    const auto start = PenguinWizardry::uptimeUs();
+    const auto res   = SMUQueue::singleton().sendBatch(ctx, kSMU12PowerUpMessages);
+    singleton().smuRecordSequence(singleton().smuPowerUpLatency, start);
+    if (res == kCAILResultOK) { onSMUPoweredUp(ctx, true); }
+    return res;
 }
 
 CAILResult X5000HWLibs::smu12InternalHwInit(void* const ctx)
 {
+    const auto start = PenguinWizardry::uptimeUs();
     if (const auto res = smu12WaitForFwLoaded(ctx); res != kCAILResultOK) { return res; }
 
-    return smu12PowerUpConfig(ctx);
+    const auto res = smu12PowerUpConfig(ctx);
+    if (res == kCAILResultOK) {
+        singleton().smuRecordColdBoot(start, kSMU12PowerUpMessages, arrsize(kSMU12PowerUpMessages));
+    }
+    return res;
 }
 
-CAILResult X5000HWLibs::smuInternalHwExit(void*) { return kCAILResultOK; }
+CAILResult X5000HWLibs::smuInternalHwExit(void*)
+{
+    onSMUPoweredDown();
+    return kCAILResultOK;
+}
 
 CAILResult X5000HWLibs::smuFullAsicReset(void* const ctx, void* data)
-{ return singleton().smuSendMessage(ctx, PPSMC_MSG_DeviceDriverReset, getMember<UInt32>(data, 4)); }
+{
+    const auto start = PenguinWizardry::uptimeUs();
+    const auto res   = singleton().smuSendMessage(ctx, PPSMC_MSG_DeviceDriverReset, getMember<UInt32>(data, 4));
+    singleton().smuRecordSequence(singleton().smuFullAsicResetLatency, start);
+    return res;
+}
 
 CAILResult X5000HWLibs::smu10NotifyEvent(void* const ctx, TTLEventInput* const input)
 {
@@ -1091,6 +1480,8 @@ CAILResult X5000HWLibs::smu10NotifyEvent(void* const ctx, TTLEventInput* const i
         return smu10PowerUpConfig(ctx);
     }
 
+    if (input->arg == SMU_EVENT_POWER_DOWN) { onSMUPoweredDown(); }
+
     return kCAILResultOK;
 }
 
@@ -1106,6 +1497,8 @@ CAILResult X5000HWLibs::smu12NotifyEvent(void* const ctx, TTLEventInput* const i
         return smu12PowerUpConfig(ctx);
     }
 
+    if (input->arg == SMU_EVENT_POWER_DOWN) { onSMUPoweredDown(); }
+
     return kCAILResultOK;
 }
 
@@ -1113,11 +1506,13 @@ CAILResult X5000HWLibs::smuFullScreenEvent(void* const ctx, const TTLFullScreenE
 {
     switch (event) {
         case TTL_FULLSCREEN_EVENT_INCREASE:
+            DPMBoost::singleton().fullscreenEvent(true);
             singleton().smuCgsWriteRegister(
                 ctx, MP1_SMN_FPS_CNT, 0,
                 singleton().smuCgsReadRegister(ctx, MP1_SMN_FPS_CNT, 0, kCAILHWBlockMP1, 0) + 1, kCAILHWBlockMP1, 0);
             return kCAILResultOK;
         case TTL_FULLSCREEN_EVENT_RESET:
+            DPMBoost::singleton().fullscreenEvent(false);
             singleton().smuCgsWriteRegister(ctx, MP1_SMN_FPS_CNT, 0, 0, kCAILHWBlockMP1, 0);
             return kCAILResultOK;
         default:
@@ -1236,24 +1631,6 @@ void X5000HWLibs::gc93GetFwConstants(void* const ctx, GCFirmwareInfo* const fwDa
     setGCFWData(ctx, fwData, kGCFirmwareTypeMECJT1, &gc_9_3_mec_jt_ucode);
 }
 
-// Port of `*_char_to_int` from HWLibs.
-static constexpr UInt32 charToInt(const char* str, size_t len)
-{
-    if (str == nullptr || len == 0) { return 0; }
-    UInt32 ret = 0;
-    while (len > 0) {
-        char c = *str;
-        if (c < '0' || c > '9') { ret = 0; }
-        else {
-            ret *= 10;
-            ret += static_cast<UInt32>(c - '0');
-        }
-        str += 1;
-        len -= 1;
-    }
-    return ret;
-}
-
 void X5000HWLibs::processGCFWEntries(void* const ctx, void* const initData)
 {
     const auto& fwInfo    = singleton().gcSwFirmwareField(ctx);
@@ -1267,7 +1644,7 @@ void X5000HWLibs::processGCFWEntries(void* const ctx, void* const initData)
         fwEntries[swIndex].romSize     = fwInfo.entry[i]->romSize;
         fwEntries[swIndex].handle      = fwInfo.handle[i];
         fwEntries[swIndex].payloadOff  = (i == kGCFirmwareTypeMEC1 || i == kGCFirmwareTypeMEC2) ? 0x1000 : 0x0;
-        fwEntries[swIndex].version     = charToInt(fwInfo.entry[i]->version, strlen(fwInfo.entry[i]->version));
+        fwEntries[swIndex].version     = fwInfo.entry[i]->versionNumber;
         fwEntries[swIndex].field24     = fwInfo.entry[i]->field8;
         swIndex                       += 1;
         if (swIndex == fwInfo.count) { break; }
@@ -1291,6 +1668,9 @@ CAILResult X5000HWLibs::wrapGcSetFwEntryInfo(void* const ctx, const SWIPIPVersio
         } break;
         default: return FunctionCast(wrapGcSetFwEntryInfo, singleton().orgGcSetFwEntryInfo)(ctx, ipVersion, initData);
     }
+    for (const auto* const entry : fwInfo->entry) {
+        if (entry != nullptr && !verifyFirmware(entry->rom)) { return kCAILResultFailed; }
+    }
     processGCFWEntries(ctx, initData);
     return kCAILResultOK;
 }
@@ -1331,7 +1711,8 @@ bool X5000HWLibs::getDcn1FwConstants(void* const ctx, DMCUFirmwareInfo* const fw
         default: SYSLOG("HWLibs", "Invalid ABM Level (0x%X) for DCN 1!", abmLevel); return false;
     }
 
-    return true;
+    return verifyFirmware(fwData->entry[kDMCUFirmwareTypeERAM].rom)
+           && verifyFirmware(fwData->entry[kDMCUFirmwareTypeISR].rom);
 }
 
 bool X5000HWLibs::getDcn21FwConstants(void* const ctx, DMCUFirmwareInfo* const fwData)
@@ -1362,11 +1743,13 @@ bool X5000HWLibs::getDcn21FwConstants(void* const ctx, DMCUFirmwareInfo* const f
         default: SYSLOG("HWLibs", "Invalid ABM Level (0x%X) for DCN 2.1!", abmLevel); return false;
     }
 
-    return true;
+    return verifyFirmware(fwData->entry[kDMCUFirmwareTypeERAM].rom)
+           && verifyFirmware(fwData->entry[kDMCUFirmwareTypeISR].rom);
 }
 
 static bool sdma41GetFWConstants(void*, const SDMAFWConstant** const out)
 {
+    if (!verifyFirmware(sdma_4_1_ucode.rom)) { return false; }
     *out = &sdma_4_1_ucode;
     return true;
 }
@@ -1378,6 +1761,9 @@ bool X5000HWLibs::sdma412StartEngine(void* const ctx)
         singleton().sdmaCgsReadRegister(ctx, SDMA0_F32_CNTL, 0, /*ctx->hwblock.id*/ kCAILHWBlockSDMA0)
             & ~SDMA0_F32_CNTL_HALT,
         /*ctx->hwblock.id*/ kCAILHWBlockSDMA0);
+    // By now CAIL has put GC and SDMA back to their defaults, e.g. on resume.
+    ClockGating::singleton().reapply();
+    SDMAQueue::singleton().start();
     return true;
 }
 
@@ -5,9 +5,9 @@
 
 #pragma once
 #include <GPUDriversAMD/CAIL/DeviceType.hpp>
+#include <GPUDriversAMD/CAIL/GoldenSettings.hpp>
 #include <GPUDriversAMD/CAIL/HWBlock.hpp>
 #include <GPUDriversAMD/CAIL/Result.hpp>
-#include <GPUDriversAMD/TTL/COS.hpp>
 #include <GPUDriversAMD/TTL/Event.hpp>
 #include <GPUDriversAMD/TTL/SWIP/DMCU.hpp>
 #include <GPUDriversAMD/TTL/SWIP/GC.hpp>
@@ -16,7 +16,9 @@
 #include <GPUDriversAMD/TTL/SWIP/SMU.hpp>
 #include <Headers/kern_patcher.hpp>
 #include <Headers/kern_util.hpp>
+#include <PenguinWizardry/LatencyHistogram.hpp>
 #include <PenguinWizardry/ObjectField.hpp>
+#include <SMUQueue.hpp>
 
 class X5000HWLibs
 {
@@ -49,8 +51,17 @@ class X5000HWLibs
     mach_vm_address_t                                            orgSmuInitFunctionPointerList{0};
     mach_vm_address_t                                            orgGcSetFwEntryInfo{0};
     mach_vm_address_t                                            orgSdmaInitFunctionPointerList{0};
+    UInt32                                                       pspSkipTAMask{0};
+    PenguinWizardry::LatencyHistogram                            smuPowerUpLatency{};
+    PenguinWizardry::LatencyHistogram                            smuFullAsicResetLatency{};
+    PenguinWizardry::LatencyHistogram                            smuFwLoadLatency{};
+    bool                                                         smuColdBootRecorded{false};
+    UInt64                                                       smuColdBootMessages{0};
+    UInt64                                                       smuColdBootMailboxUs{0};
+    UInt64                                                       smuColdBootUs{0};
+    UInt64                                                       smuColdBootReplayUs{0};
+    const CAILIPGoldenRegisters*                                 goldenSettings{nullptr};
     CAILResult (*smu90SendMessageWithParameter)(void* ctx, UInt32 message, UInt32 param){nullptr};
-    CAILResult (*smuCosWaitFor)(void* ctx, CosWaitForFunc* func, void* handle, UInt32 duration){nullptr};
     UInt32     (*smuCgsReadRegister)(void* ctx, UInt32 regOff, UInt32 blockInstance, CAILHWBlock block,
                                      UInt32 regOffBase){nullptr};
     void   (*smuCgsWriteRegister)(void* ctx, UInt32 regOff, UInt32 blockInstance, UInt32 regValue, CAILHWBlock block,
@@ -64,8 +75,12 @@ public:
 
     X5000HWLibs();
 
+    void stageFirmware();
     void processKext(KernelPatcher& patcher, size_t id, mach_vm_address_t slide, size_t size);
 
+    // Opt-in through `-NRedGoldenVerify`, publishes whatever doesn't match as `NRedGoldenMismatches`.
+    void verifyGoldenSettings() const;
+
 private:
     static void       wrapPopulateFirmwareDirectory(void* self);
     static bool       wrapGetIpFw(void* self, UInt32 ipVersion, const char* name, void* out);
@@ -76,8 +91,13 @@ private:
     static CAILResult pspSecurityFeatureCapsSet10(void* ctx);
     static CAILResult pspSecurityFeatureCapsSet12(void* ctx);
     static CAILResult wrapPspCmdKmSubmit(void* ctx, void* cmd, void* outData, void* outResponse);
+    static CAILResult smuMailboxSend(void* ctx, UInt32 message, UInt32 param, UInt32* outParam);
     CAILResult        smuSendMessage(void* ctx, UInt32 message, UInt32 param = 0, UInt32* outParam = nullptr) const;
-    static CAILResult smuPowerUpConfigCommon(void* ctx);
+    void              publishSMUStats() const;
+    void              smuRecordSequence(PenguinWizardry::LatencyHistogram& histogram, UInt64 startUs);
+    void              smuRecordColdBoot(UInt64 startUs, const SMUMessage* powerUp, size_t powerUpCount);
+    static void       onSMUPoweredUp(void* ctx, bool hasMetricsTable);
+    static void       onSMUPoweredDown();
     static CAILResult smuInternalSwInit(void* ctx, void* input, AMDSMUSWInitOutput* output);
     static CAILResult smuInternalSwInitOld(void* ctx, void* input, AMDSMUSWInitOutput* output);
     static CAILResult smuGetUCodeConsts(void* ctx, AMDSMUUCodeConstants* consts);
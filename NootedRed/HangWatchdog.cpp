@@ -0,0 +1,133 @@
+// Hang Watchdog
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <GPUDriversAMD/RavenIPOffset.hpp>
+#include <GfxOff.hpp>
+#include <HangWatchdog.hpp>
+#include <Headers/kern_util.hpp>
+#include <NRed.hpp>
+#include <PenguinWizardry/Stats.hpp>
+#include <Regs/GC.hpp>
+#include <Regs/SDMA0.hpp>
+#include <libkern/c++/OSDictionary.h>
+#include <libkern/c++/OSString.h>
+
+// Feeds a mock ring through the watch and returns the event of every step, packed 2 bits each.
+template<size_t N>
+static constexpr UInt32 replay(const RingPointers (&steps)[N], const UInt32 stallSamples)
+{
+    RingWatch watch{};
+    UInt32    ret = 0;
+    for (size_t i = 0; i < N; i += 1) { ret |= static_cast<UInt32>(watch.update(steps[i], stallSamples)) << (i * 2); }
+    return ret;
+}
+
+static constexpr UInt32 S = static_cast<UInt32>(RingWatchEvent::Stalled);
+static constexpr UInt32 R = static_cast<UInt32>(RingWatchEvent::Recovered);
+
+static constexpr RingPointers kIdleRing[]    = {{0, 0}, {0, 0}, {0, 0}, {0, 0}};
+static constexpr RingPointers kBusyRing[]    = {{0, 8}, {4, 8}, {6, 12}, {10, 12}};
+static constexpr RingPointers kStalledRing[] = {{0, 8}, {4, 8}, {4, 8}, {4, 8}, {4, 12}, {4, 12}, {8, 12}, {12, 12}};
+
+static_assert(replay(kIdleRing, 2) == 0);
+static_assert(replay(kBusyRing, 2) == 0);
+// Stalls on the third sample without progress, stays quiet while still stuck, then recovers once.
+static_assert(replay(kStalledRing, 3) == ((S << 8) | (R << 12)));
+static_assert(replay(kStalledRing, 5) == 0);
+
+static HangWatchdog moduleInstance;
+
+HangWatchdog& HangWatchdog::singleton() { return moduleInstance; }
+
+void HangWatchdog::init()
+{
+    if (this->sampler.isEnabled() || !checkKernelArgument("-NRedHangWatchdog")) { return; }
+
+    this->sampler.init("HangWatchdog", this, &HangWatchdog::sampleLocked, SAMPLE_INTERVAL_MS);
+    SYSLOG("HangWatchdog", "Enabled");
+}
+
+void HangWatchdog::start()
+{
+    if (!this->sampler.isEnabled()) { return; }
+
+    this->sampler.start([this] {
+        this->cp   = {};
+        this->sdma = {};
+        return true;
+    });
+}
+
+void HangWatchdog::stop()
+{
+    if (!this->sampler.isEnabled()) { return; }
+
+    this->sampler.stop([] {});
+}
+
+void HangWatchdog::report(const char* const ring, const HangSnapshot& snapshot)
+{
+    SYSLOG("HangWatchdog",
+           "%s ring stalled: GRBM_STATUS=0x%X GRBM_STATUS2=0x%X GRBM_STATUS_SE0=0x%X SDMA0_STATUS=0x%X CP=0x%X/0x%X "
+           "SDMA0=0x%X/0x%X",
+           ring, snapshot.grbmStatus, snapshot.grbmStatus2, snapshot.grbmStatusSE0, snapshot.sdmaStatus,
+           snapshot.cpRptr, snapshot.cpWptr, snapshot.sdmaRptr, snapshot.sdmaWptr);
+
+    auto* const dict = OSDictionary::withCapacity(9);
+    if (dict == nullptr) { return; }
+
+    PenguinWizardry::setStatsObject(dict, "Ring", OSString::withCString(ring));
+    PenguinWizardry::setStatsNumber(dict, "GRBM_STATUS", snapshot.grbmStatus);
+    PenguinWizardry::setStatsNumber(dict, "GRBM_STATUS2", snapshot.grbmStatus2);
+    PenguinWizardry::setStatsNumber(dict, "GRBM_STATUS_SE0", snapshot.grbmStatusSE0);
+    PenguinWizardry::setStatsNumber(dict, "SDMA0_STATUS_REG", snapshot.sdmaStatus);
+    PenguinWizardry::setStatsNumber(dict, "CP_RB0_RPTR", snapshot.cpRptr);
+    PenguinWizardry::setStatsNumber(dict, "CP_RB0_WPTR", snapshot.cpWptr);
+    PenguinWizardry::setStatsNumber(dict, "SDMA0_GFX_RB_RPTR", snapshot.sdmaRptr);
+    PenguinWizardry::setStatsNumber(dict, "SDMA0_GFX_RB_WPTR", snapshot.sdmaWptr);
+    NRed::singleton().setProp("NRedHangSnapshot", dict);
+    dict->release();
+}
+
+bool HangWatchdog::sampleLocked()
+{
+    const auto&  nred     = NRed::singleton();
+    HangSnapshot snapshot = {
+        .sdmaStatus = nred.readReg32(SDMA0_BASE_0 + SDMA0_STATUS_REG),
+        .sdmaRptr   = nred.readReg32(SDMA0_BASE_0 + SDMA0_GFX_RB_RPTR),
+        .sdmaWptr   = nred.readReg32(SDMA0_BASE_0 + SDMA0_GFX_RB_WPTR),
+    };
+    // GC under GFXOFF has nothing queued, so the CP ring counts as idle instead of waking it up.
+    snapshot.cpRptr = snapshot.cpWptr = this->cp.lastRptr;
+    GfxOff::singleton().ifPowered([&nred, &snapshot] {
+        snapshot.grbmStatus    = nred.readReg32(GC_BASE_0 + GRBM_STATUS);
+        snapshot.grbmStatus2   = nred.readReg32(GC_BASE_0 + GRBM_STATUS2);
+        snapshot.grbmStatusSE0 = nred.readReg32(GC_BASE_0 + GRBM_STATUS_SE0);
+        snapshot.cpRptr        = nred.readReg32(GC_BASE_0 + CP_RB0_RPTR);
+        snapshot.cpWptr        = nred.readReg32(GC_BASE_0 + CP_RB0_WPTR);
+    });
+
+    const struct {
+        const char*  name;
+        RingWatch&   watch;
+        RingPointers ptrs;
+    } rings[] = {
+        {"CP", this->cp, {snapshot.cpRptr, snapshot.cpWptr}},
+        {"SDMA0", this->sdma, {snapshot.sdmaRptr, snapshot.sdmaWptr}},
+    };
+    for (const auto& ring : rings) {
+        switch (ring.watch.update(ring.ptrs, STALL_SAMPLES)) {
+            case RingWatchEvent::Stalled:
+                report(ring.name, snapshot);
+                break;
+            case RingWatchEvent::Recovered:
+                SYSLOG("HangWatchdog", "%s ring is making progress again", ring.name);
+                break;
+            default:
+                break;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,79 @@
+// Hang Watchdog
+// Watches the CP and SDMA0 ring pointers and takes a register snapshot when one stops making progress.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOTypes.h>
+#include <PenguinWizardry/PeriodicCall.hpp>
+
+struct RingPointers
+{
+    UInt32 rptr;
+    UInt32 wptr;
+};
+
+enum struct RingWatchEvent
+{
+    None,
+    Stalled,      // Only reported once per stall.
+    Recovered,    // The read pointer moved again after a reported stall.
+};
+
+// A ring has stalled once it has had work pending without the read pointer moving for `stallSamples` samples.
+struct RingWatch
+{
+    UInt32 lastRptr{0};
+    UInt32 stuckSamples{0};
+    bool   stalled{false};
+
+    constexpr RingWatchEvent update(const RingPointers& ptrs, const UInt32 stallSamples)
+    {
+        const bool progressed = ptrs.rptr == ptrs.wptr || ptrs.rptr != this->lastRptr;
+        this->lastRptr        = ptrs.rptr;
+        if (progressed) {
+            this->stuckSamples = 0;
+            if (!this->stalled) { return RingWatchEvent::None; }
+            this->stalled = false;
+            return RingWatchEvent::Recovered;
+        }
+        if (this->stalled || ++this->stuckSamples < stallSamples) { return RingWatchEvent::None; }
+        this->stalled = true;
+        return RingWatchEvent::Stalled;
+    }
+};
+
+struct HangSnapshot
+{
+    UInt32 grbmStatus{0};
+    UInt32 grbmStatus2{0};
+    UInt32 grbmStatusSE0{0};
+    UInt32 sdmaStatus{0};
+    UInt32 cpRptr{0};
+    UInt32 cpWptr{0};
+    UInt32 sdmaRptr{0};
+    UInt32 sdmaWptr{0};
+};
+
+class HangWatchdog
+{
+    static constexpr UInt32 SAMPLE_INTERVAL_MS = 500;
+    static constexpr UInt32 STALL_SAMPLES      = 10;
+
+    PenguinWizardry::PeriodicCall<HangWatchdog> sampler{};
+    RingWatch                                   cp{};
+    RingWatch                                   sdma{};
+
+public:
+    static HangWatchdog& singleton();
+
+    // Opt-in through `-NRedHangWatchdog`, everything below is a no-op otherwise.
+    void init();
+    void start();
+    void stop();
+
+private:
+    bool        sampleLocked();
+    static void report(const char* ring, const HangSnapshot& snapshot);
+};
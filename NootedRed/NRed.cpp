@@ -32,6 +32,7 @@
 #include <X6000FB.hpp>
 #include <kern/clock.h>
 #include <libkern/OSTypes.h>
+#include <libkern/c++/OSDictionary.h>
 #include <libkern/c++/OSMetaClass.h>
 #include <mach/i386/vm_types.h>
 
@@ -48,6 +49,9 @@ void NRed::init()
     SYSLOG("NRed", "| Change the world for the better.                                |");
     SYSLOG("NRed", "|-----------------------------------------------------------------|");
 
+    this->statsLock = IOLockAlloc();
+    PANIC_COND(this->statsLock == nullptr, "NRed", "Failed to allocate statistics lock");
+
     Backlight::singleton().init();
 
     lilu.onKextLoadForce(&kextRadeonX6000Framebuffer);
@@ -173,6 +177,9 @@ void NRed::processPatcher()
     }
     this->pciRevision = static_cast<UInt8>(WIOKit::readPCIConfigValue(this->iGPU, WIOKit::kIOPCIConfigRevisionID));
 
+    // Verifying the firmware can overlap with the rest of the boot until HWLibs actually needs it.
+    X5000HWLibs::singleton().stageFirmware();
+
     char name[128];
     for (size_t i = 0, ii = 0; i < devInfo->videoExternal.size(); i++) {
         auto device = OSDynamicCast(IOPCIDevice, devInfo->videoExternal[i].video);
@@ -188,6 +195,39 @@ void NRed::processPatcher()
 
 void NRed::setProp32(const char* const key, const UInt32 value) const { this->iGPU->setProperty(key, value, 32); }
 
+void NRed::setProp(const char* const key, OSObject* const value) const { this->iGPU->setProperty(key, value); }
+
+// The accelerator owns the dictionary and replaces it on its own schedule, so the keys are merged into a copy.
+// Our samplers are serialised against each other, but not against the accelerator. If it publishes between the copy
+// and the write, its update is lost, and if it publishes after, ours is until the next sample, so the keys are
+// best-effort.
+void NRed::mergePerformanceStatistics(OSDictionary* const stats) const
+{
+    auto* const iterator = this->iGPU->getChildIterator(gIOServicePlane);
+    if (iterator == nullptr) { return; }
+
+    IOLockLock(this->statsLock);
+
+    while (auto* const entry = iterator->getNextObject()) {
+        auto* const child = OSDynamicCast(IOService, entry);
+        if (child == nullptr || child->metaCast("IOAccelerator") == nullptr) { continue; }
+
+        auto* const property = child->copyProperty("PerformanceStatistics");
+        auto* const current  = OSDynamicCast(OSDictionary, property);
+        auto* const merged =
+            current == nullptr ? OSDictionary::withCapacity(stats->getCount()) : OSDictionary::withDictionary(current);
+        if (property != nullptr) { property->release(); }
+        if (merged != nullptr) {
+            merged->merge(stats);
+            child->setProperty("PerformanceStatistics", merged);
+            merged->release();
+        }
+        break;
+    }
+    IOLockUnlock(this->statsLock);
+    iterator->release();
+}
+
 UInt32 NRed::readReg32(const UInt32 reg) const
 {
     if ((reg * sizeof(UInt32)) < this->rmmio->getLength()) { return this->rmmioPtr[reg]; }
@@ -196,3 +236,12 @@ UInt32 NRed::readReg32(const UInt32 reg) const
         return this->rmmioPtr[PCIE_DATA2];
     }
 }
+
+void NRed::writeReg32(const UInt32 reg, const UInt32 value) const
+{
+    if ((reg * sizeof(UInt32)) < this->rmmio->getLength()) { this->rmmioPtr[reg] = value; }
+    else {
+        this->rmmioPtr[PCIE_INDEX2] = reg;
+        this->rmmioPtr[PCIE_DATA2]  = value;
+    }
+}
@@ -8,6 +8,7 @@
 #include <GPUDriversAMD/CAIL/Result.hpp>
 #include <GPUDriversAMD/PowerPlay.hpp>
 #include <Headers/kern_patcher.hpp>
+#include <IOKit/IOLocks.h>
 #include <IOKit/pci/IOPCIDevice.h>
 
 class NRed
@@ -36,15 +37,16 @@ class NRed
         constexpr void setGreenSardine() { this->value |= IsGreenSardine; }
     };
 
-    Attributes       attributes;           // TODO: Remove!
-    IOPCIDevice*     iGPU{nullptr};        // TODO: Remove!
-    IOMemoryMap*     rmmio{nullptr};       // TODO: Remove!
-    volatile UInt32* rmmioPtr{nullptr};    // TODO: Remove!
-    UInt16           deviceID{0};          // TODO: Remove!
-    UInt8            pciRevision{0};       // TODO: Remove!
-    UInt16           devRevision{0};       // TODO: Remove!
-    UInt16           enumRevision{0};      // TODO: Remove!
-    UInt64           fbOffset{0};          // TODO: Remove!
+    Attributes       attributes;            // TODO: Remove!
+    IOPCIDevice*     iGPU{nullptr};         // TODO: Remove!
+    IOMemoryMap*     rmmio{nullptr};        // TODO: Remove!
+    volatile UInt32* rmmioPtr{nullptr};     // TODO: Remove!
+    UInt16           deviceID{0};           // TODO: Remove!
+    UInt8            pciRevision{0};        // TODO: Remove!
+    UInt16           devRevision{0};        // TODO: Remove!
+    UInt16           enumRevision{0};       // TODO: Remove!
+    UInt64           fbOffset{0};           // TODO: Remove!
+    IOLock*          statsLock{nullptr};    // Serialises our `PerformanceStatistics` writers.
 
 public:
     static NRed& singleton();
@@ -60,6 +62,9 @@ public:
     void hwLateInit();        // TODO: Remove!
     void processPatcher();    // TODO: Remove!
 
-    void   setProp32(const char* key, UInt32 value) const;    // TODO: Remove!
-    UInt32 readReg32(UInt32 reg) const;                       // TODO: Remove!
+    void   setProp32(const char* key, UInt32 value) const;          // TODO: Remove!
+    void   setProp(const char* key, OSObject* value) const;         // TODO: Remove!
+    void   mergePerformanceStatistics(OSDictionary* stats) const;    // TODO: Remove!
+    UInt32 readReg32(UInt32 reg) const;                             // TODO: Remove!
+    void   writeReg32(UInt32 reg, UInt32 value) const;              // TODO: Remove!
 };
@@ -0,0 +1,55 @@
+// Relaxed Atomics Usable in Constant Expressions
+// Plain loads and stores while constant-evaluated, so lock-free counters can be checked with `static_assert`.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+
+namespace PenguinWizardry
+{
+
+    template<typename T>
+    constexpr T atomicLoadRelaxed(const T& value)
+    {
+        if consteval { return value; }
+        else {
+            return __atomic_load_n(&value, __ATOMIC_RELAXED);
+        }
+    }
+
+    template<typename T>
+    constexpr void atomicAddRelaxed(T& value, const T delta)
+    {
+        if consteval { value += delta; }
+        else {
+            __atomic_fetch_add(&value, delta, __ATOMIC_RELAXED);
+        }
+    }
+
+    // Updates `expected` to the current value on failure, like `__atomic_compare_exchange_n`.
+    template<typename T>
+    constexpr bool atomicCompareExchangeRelaxed(T& value, T& expected, const T desired)
+    {
+        if consteval {
+            if (value != expected) {
+                expected = value;
+                return false;
+            }
+            value = desired;
+            return true;
+        }
+        else {
+            return __atomic_compare_exchange_n(&value, &expected, desired, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+        }
+    }
+
+    template<typename T>
+    constexpr void atomicMaxRelaxed(T& value, const T candidate)
+    {
+        for (auto current = atomicLoadRelaxed(value); candidate > current;) {
+            if (atomicCompareExchangeRelaxed(value, current, candidate)) { break; }
+        }
+    }
+
+}    // namespace PenguinWizardry
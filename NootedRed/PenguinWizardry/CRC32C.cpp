@@ -0,0 +1,23 @@
+// CRC-32C (Castagnoli)
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <PenguinWizardry/CRC32C.hpp>
+
+// Raven and Renoir are Zen APUs, SSE4.2 is always there; no need for a fallback.
+// A single `crc32q` stream does several GB/s, which is plenty for a couple MBs of firmware.
+[[gnu::target("sse4.2")]]
+UInt32 PenguinWizardry::crc32c(const void* const data, size_t size)
+{
+    auto*  bytes = static_cast<const UInt8*>(data);
+    UInt64 crc   = 0xFFFFFFFF;
+    for (; size >= sizeof(UInt64); size -= sizeof(UInt64), bytes += sizeof(UInt64)) {
+        UInt64 value;
+        __builtin_memcpy(&value, bytes, sizeof(UInt64));
+        crc = __builtin_ia32_crc32di(crc, value);
+    }
+    auto crc32 = static_cast<UInt32>(crc);
+    for (; size != 0; size -= 1, bytes += 1) { crc32 = __builtin_ia32_crc32qi(crc32, *bytes); }
+    return ~crc32;
+}
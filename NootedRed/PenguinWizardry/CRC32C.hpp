@@ -0,0 +1,47 @@
+// CRC-32C (Castagnoli)
+// Same polynomial as the SSE4.2 `crc32` instruction, so build-time digests can be checked with it at runtime.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOTypes.h>
+
+namespace PenguinWizardry
+{
+
+    namespace CRC32CDetail
+    {
+        static constexpr UInt32 POLYNOMIAL = 0x82F63B78;    // Reflected.
+
+        struct Table
+        {
+            UInt32 value[0x100]{};
+
+            consteval Table()
+            {
+                for (UInt32 i = 0; i < 0x100; i += 1) {
+                    UInt32 crc = i;
+                    for (UInt32 bit = 0; bit < 8; bit += 1) { crc = (crc >> 1) ^ ((crc & 1) != 0 ? POLYNOMIAL : 0); }
+                    this->value[i] = crc;
+                }
+            }
+        };
+
+        static constexpr Table TABLE{};
+    }    // namespace CRC32CDetail
+
+    // Only meant for embedded blobs, e.g. `#embed`'d firmware. Large inputs need a raised `-fconstexpr-steps`.
+    template<const size_t N>
+    consteval UInt32 crc32c(const char (&data)[N])
+    {
+        UInt32 crc = 0xFFFFFFFF;
+        for (size_t i = 0; i < N; i += 1) {
+            crc = CRC32CDetail::TABLE.value[(crc ^ static_cast<UInt8>(data[i])) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    UInt32 crc32c(const void* data, size_t size);
+
+}    // namespace PenguinWizardry
@@ -0,0 +1,39 @@
+// Lock-free Latency Histogram
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <PenguinWizardry/LatencyHistogram.hpp>
+#include <PenguinWizardry/Stats.hpp>
+#include <libkern/c++/OSArray.h>
+#include <libkern/c++/OSDictionary.h>
+#include <libkern/c++/OSNumber.h>
+
+OSDictionary* PenguinWizardry::LatencyHistogram::copyDictionary() const
+{
+    const auto snapshot = this->snapshot();
+
+    auto* dict    = OSDictionary::withCapacity(4);
+    auto* buckets = OSArray::withCapacity(BUCKET_COUNT);
+    if (dict == nullptr || buckets == nullptr) {
+        OSSafeReleaseNULL(dict);
+        OSSafeReleaseNULL(buckets);
+        return nullptr;
+    }
+
+    const auto used = usedBuckets(snapshot);
+    for (size_t i = 0; i < used; i += 1) {
+        auto* const number = OSNumber::withNumber(snapshot.buckets[i], 64);
+        if (number == nullptr) { break; }
+        buckets->setObject(number);
+        number->release();
+    }
+    dict->setObject("Buckets", buckets);
+    buckets->release();
+
+    setStatsNumber(dict, "Count", snapshot.count);
+    setStatsNumber(dict, "TotalUs", snapshot.totalUs);
+    setStatsNumber(dict, "MaxUs", snapshot.maxUs);
+
+    return dict;
+}
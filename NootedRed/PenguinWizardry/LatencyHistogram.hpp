@@ -0,0 +1,138 @@
+// Lock-free Latency Histogram
+// Bucket `i` counts samples in [2^i, 2^(i+1)) microseconds, bucket 0 also takes anything below 1us.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOTypes.h>
+#include <PenguinWizardry/Atomic.hpp>
+
+class OSDictionary;
+
+namespace PenguinWizardry
+{
+
+    class LatencyHistogram
+    {
+    public:
+        static constexpr size_t BUCKET_COUNT = 24;    // Last bucket is open-ended, starting at ~8.4s.
+
+        struct Snapshot
+        {
+            UInt64 buckets[BUCKET_COUNT]{};
+            UInt64 count{0};
+            UInt64 totalUs{0};
+            UInt64 maxUs{0};
+        };
+
+    private:
+        UInt64 buckets[BUCKET_COUNT]{};
+        UInt64 count{0};
+        UInt64 totalUs{0};
+        UInt64 maxUs{0};
+
+    public:
+        static constexpr size_t bucketFor(const UInt64 us)
+        {
+            if (us == 0) { return 0; }
+            const auto bucket = static_cast<size_t>(63 - __builtin_clzll(us));
+            return bucket < BUCKET_COUNT ? bucket : BUCKET_COUNT - 1;
+        }
+
+        // Buckets up to and including the last non-empty one.
+        static constexpr size_t usedBuckets(const Snapshot& snapshot)
+        {
+            size_t used = BUCKET_COUNT;
+            while (used != 0 && snapshot.buckets[used - 1] == 0) { used -= 1; }
+            return used;
+        }
+
+        constexpr void record(const UInt64 us)
+        {
+            atomicAddRelaxed(this->buckets[bucketFor(us)], UInt64{1});
+            atomicAddRelaxed(this->count, UInt64{1});
+            atomicAddRelaxed(this->totalUs, us);
+            atomicMaxRelaxed(this->maxUs, us);
+        }
+
+        constexpr UInt64 getCount() const { return atomicLoadRelaxed(this->count); }
+
+        // Not atomic as a whole; good enough for reporting.
+        constexpr Snapshot snapshot() const
+        {
+            Snapshot ret;
+            for (size_t i = 0; i < BUCKET_COUNT; i += 1) { ret.buckets[i] = atomicLoadRelaxed(this->buckets[i]); }
+            ret.count   = atomicLoadRelaxed(this->count);
+            ret.totalUs = atomicLoadRelaxed(this->totalUs);
+            ret.maxUs   = atomicLoadRelaxed(this->maxUs);
+            return ret;
+        }
+
+        // `Count`, `TotalUs`, `MaxUs` and `Buckets`, trailing empty buckets are left out.
+        OSDictionary* copyDictionary() const;
+    };
+
+}    // namespace PenguinWizardry
+
+namespace LatencyHistogramTests
+{
+    using PenguinWizardry::LatencyHistogram;
+
+    static_assert(LatencyHistogram::bucketFor(0) == 0);
+    static_assert(LatencyHistogram::bucketFor(1) == 0);
+    static_assert(LatencyHistogram::bucketFor(2) == 1);
+    static_assert(LatencyHistogram::bucketFor(3) == 1);
+    static_assert(LatencyHistogram::bucketFor(1023) == 9);
+    static_assert(LatencyHistogram::bucketFor(1024) == 10);
+    static_assert(LatencyHistogram::bucketFor((1ULL << 23) - 1) == 22);
+    static_assert(LatencyHistogram::bucketFor(1ULL << 23) == 23);
+    static_assert(LatencyHistogram::bucketFor(~0ULL) == LatencyHistogram::BUCKET_COUNT - 1);
+
+    constexpr bool startsEmpty()
+    {
+        const LatencyHistogram histogram{};
+        const auto             snapshot = histogram.snapshot();
+        return histogram.getCount() == 0 && snapshot.totalUs == 0 && snapshot.maxUs == 0
+               && LatencyHistogram::usedBuckets(snapshot) == 0;
+    }
+    static_assert(startsEmpty());
+
+    // A fast mailbox round trip, two slow ones and a timeout.
+    constexpr bool accumulates()
+    {
+        LatencyHistogram histogram{};
+        histogram.record(40);
+        histogram.record(1500);
+        histogram.record(1100);
+        histogram.record(2000000);
+        const auto snapshot = histogram.snapshot();
+        return snapshot.count == 4 && snapshot.totalUs == 2002640 && snapshot.maxUs == 2000000
+               && snapshot.buckets[5] == 1 && snapshot.buckets[10] == 2 && snapshot.buckets[20] == 1
+               && LatencyHistogram::usedBuckets(snapshot) == 21;
+    }
+    static_assert(accumulates());
+
+    constexpr bool keepsMaxAcrossSmallerSamples()
+    {
+        LatencyHistogram histogram{};
+        histogram.record(900);
+        histogram.record(3);
+        histogram.record(0);
+        const auto snapshot = histogram.snapshot();
+        return snapshot.maxUs == 900 && snapshot.buckets[0] == 1 && snapshot.buckets[1] == 1
+               && LatencyHistogram::usedBuckets(snapshot) == 10;
+    }
+    static_assert(keepsMaxAcrossSmallerSamples());
+
+    constexpr bool clampsIntoLastBucket()
+    {
+        LatencyHistogram histogram{};
+        histogram.record(60000000);
+        const auto snapshot = histogram.snapshot();
+        return snapshot.buckets[LatencyHistogram::BUCKET_COUNT - 1] == 1
+               && LatencyHistogram::usedBuckets(snapshot) == LatencyHistogram::BUCKET_COUNT;
+    }
+    static_assert(clampsIntoLastBucket());
+
+}    // namespace LatencyHistogramTests
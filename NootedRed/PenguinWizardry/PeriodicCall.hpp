@@ -0,0 +1,84 @@
+// Locked Periodic Thread Call
+// The lock, thread call and start/stop bookkeeping every NootedRed sampler used to carry a copy of.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <Headers/kern_util.hpp>
+#include <IOKit/IOLocks.h>
+#include <IOKit/IOTypes.h>
+#include <kern/clock.h>
+#include <kern/thread_call.h>
+
+namespace PenguinWizardry
+{
+
+    // `tick` runs on a thread call with the lock held, and the call is re-armed if it returns true. It may drop the
+    // lock in between, nothing is re-armed if `stop` ran in the meantime.
+    template<typename T>
+    class PeriodicCall
+    {
+        IOLock*       lock{nullptr};
+        thread_call_t call{nullptr};
+        T*            owner{nullptr};
+        bool (T::*tick)(){nullptr};
+        UInt32        intervalMs{0};
+        bool          running{false};
+
+        static void thread(thread_call_param_t param0, thread_call_param_t)
+        {
+            auto* const self = static_cast<PeriodicCall*>(param0);
+            IOLockLock(self->lock);
+            if (self->running && (self->owner->*self->tick)() && self->running) { self->armLocked(); }
+            IOLockUnlock(self->lock);
+        }
+
+    public:
+        void init(const char* const module, T* const owner, bool (T::*const tick)(), const UInt32 intervalMs)
+        {
+            this->owner      = owner;
+            this->tick       = tick;
+            this->intervalMs = intervalMs;
+            this->lock       = IOLockAlloc();
+            PANIC_COND(this->lock == nullptr, module, "Failed to allocate lock");
+            this->call = thread_call_allocate(thread, this);
+            PANIC_COND(this->call == nullptr, module, "Failed to allocate thread call");
+        }
+
+        bool    isEnabled() const { return this->lock != nullptr; }
+        IOLock* getLock() const { return this->lock; }
+
+        // Runs `prepare` with the lock held, the first tick is armed if it returns true.
+        template<typename F>
+        void start(const F& prepare)
+        {
+            IOLockLock(this->lock);
+            this->running = true;
+            if (prepare()) { this->armLocked(); }
+            IOLockUnlock(this->lock);
+        }
+
+        // Runs `finish` with the lock held, then waits for a tick that is already running.
+        template<typename F>
+        void stop(const F& finish)
+        {
+            IOLockLock(this->lock);
+            this->running = false;
+            finish();
+            IOLockUnlock(this->lock);
+            thread_call_cancel_wait(this->call);
+        }
+
+        // Re-entering a pending call pushes its deadline out.
+        void armLocked()
+        {
+            UInt64 deadline;
+            clock_interval_to_deadline(this->intervalMs, kMillisecondScale, &deadline);
+            thread_call_enter_delayed(this->call, deadline);
+        }
+
+        void cancelLocked() { thread_call_cancel(this->call); }
+    };
+
+}    // namespace PenguinWizardry
@@ -0,0 +1,18 @@
+// Statistics Dictionary Helpers
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <PenguinWizardry/Stats.hpp>
+#include <libkern/c++/OSDictionary.h>
+#include <libkern/c++/OSNumber.h>
+
+void PenguinWizardry::setStatsNumber(OSDictionary* const dict, const char* const key, const UInt64 value)
+{ setStatsObject(dict, key, OSNumber::withNumber(value, 64)); }
+
+void PenguinWizardry::setStatsObject(OSDictionary* const dict, const char* const key, OSObject* const value)
+{
+    if (value == nullptr) { return; }
+    dict->setObject(key, value);
+    value->release();
+}
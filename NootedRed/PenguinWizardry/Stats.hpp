@@ -0,0 +1,20 @@
+// Statistics Dictionary Helpers
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOTypes.h>
+
+class OSDictionary;
+class OSObject;
+
+namespace PenguinWizardry
+{
+
+    // Silently leaves the key out if the number can't be allocated, statistics are best-effort.
+    void setStatsNumber(OSDictionary* dict, const char* key, UInt64 value);
+    // Takes over the caller's reference to `value`, nothing is set if it is null.
+    void setStatsObject(OSDictionary* dict, const char* key, OSObject* value);
+
+}    // namespace PenguinWizardry
@@ -0,0 +1,23 @@
+// Monotonic Uptime Helpers
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOTypes.h>
+#include <kern/clock.h>
+
+namespace PenguinWizardry
+{
+
+    inline UInt64 uptimeNs()
+    {
+        UInt64 abs, ns;
+        clock_get_uptime(&abs);
+        absolutetime_to_nanoseconds(abs, &ns);
+        return ns;
+    }
+
+    inline UInt64 uptimeUs() { return uptimeNs() / 1000; }
+
+}    // namespace PenguinWizardry
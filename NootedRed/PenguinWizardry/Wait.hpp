@@ -0,0 +1,91 @@
+// Adaptive Polling With a Deadline
+// Starts out spinning for short waits and backs off exponentially into sleeping for long ones.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOLib.h>
+#include <IOKit/IOTypes.h>
+#include <PenguinWizardry/Uptime.hpp>
+
+namespace PenguinWizardry
+{
+
+    struct WaitResult
+    {
+        bool   satisfied;
+        UInt64 elapsedUs;
+        UInt32 polls;
+    };
+
+    static constexpr UInt32 WAIT_SPIN_LIMIT_US = 1000;     // Anything shorter is `IODelay`'d.
+    static constexpr UInt32 WAIT_MAX_DELAY_US  = 16000;    // Upper bound between two polls.
+
+    constexpr UInt32 nextWaitDelayUs(const UInt32 delayUs)
+    { return delayUs * 2 < WAIT_MAX_DELAY_US ? delayUs * 2 : WAIT_MAX_DELAY_US; }
+
+    // The condition is always checked once more after the deadline, so oversleeping can't cause a false timeout.
+    template<typename F>
+    WaitResult waitFor(const F& condition, const UInt32 timeoutMs)
+    {
+        const auto start    = uptimeUs();
+        const auto deadline = start + static_cast<UInt64>(timeoutMs) * 1000;
+        UInt32     delayUs  = 1;
+        UInt32     polls    = 0;
+        while (true) {
+            polls += 1;
+            if (condition()) { return {true, uptimeUs() - start, polls}; }
+
+            const auto now = uptimeUs();
+            if (now >= deadline) { return {false, now - start, polls}; }
+
+            if (delayUs < WAIT_SPIN_LIMIT_US) { IODelay(delayUs); }
+            else {
+                IOSleep(delayUs / 1000);
+            }
+            delayUs = nextWaitDelayUs(delayUs);
+        }
+    }
+
+}    // namespace PenguinWizardry
+
+namespace WaitTests
+{
+    using PenguinWizardry::nextWaitDelayUs;
+
+    // Delays before the poll that sees the condition after `polls` failed ones.
+    constexpr UInt64 waitedUs(const UInt32 polls)
+    {
+        UInt64 total   = 0;
+        UInt32 delayUs = 1;
+        for (UInt32 i = 0; i < polls; i += 1) {
+            total   += delayUs;
+            delayUs  = nextWaitDelayUs(delayUs);
+        }
+        return total;
+    }
+
+    constexpr UInt32 spinningPolls()
+    {
+        UInt32 polls = 0;
+        for (UInt32 delayUs = 1; delayUs < PenguinWizardry::WAIT_SPIN_LIMIT_US; delayUs = nextWaitDelayUs(delayUs)) {
+            polls += 1;
+        }
+        return polls;
+    }
+
+    static_assert(nextWaitDelayUs(1) == 2);
+    static_assert(nextWaitDelayUs(8192) == PenguinWizardry::WAIT_MAX_DELAY_US);
+    static_assert(nextWaitDelayUs(PenguinWizardry::WAIT_MAX_DELAY_US) == PenguinWizardry::WAIT_MAX_DELAY_US);
+
+    // A firmware flag that's up within a millisecond never puts the thread to sleep.
+    static_assert(spinningPolls() == 10);
+    static_assert(waitedUs(10) == 1023);
+
+    // Past the ramp every poll is 16ms apart, so the 2s firmware load timeout costs ~140 polls, not millions.
+    static_assert(waitedUs(14) == 16383);
+    static_assert(waitedUs(15) == 16383 + 16000);
+    static_assert(waitedUs(138) > 2000000 && waitedUs(137) < 2000000);
+
+}    // namespace WaitTests
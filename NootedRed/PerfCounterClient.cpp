@@ -0,0 +1,59 @@
+// Performance Counter User Client
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <PerfCounterClient.hpp>
+#include <PerfCounters.hpp>
+
+OSDefineMetaClassAndStructors(NRedPerfCounterClient, IOUserClient);
+
+const IOExternalMethodDispatch NRedPerfCounterClient::methods[] = {
+    {beginSession, kIOUCVariableStructureSize, 0, 0, 0},
+    {endSession, 0, 0, PERF_COUNTER_SLOTS, 0},
+};
+
+bool NRedPerfCounterClient::initWithTask(task_t const owningTask, void* const securityToken, const UInt32 type,
+                                         OSDictionary* const properties)
+{
+    if (clientHasPrivilege(securityToken, kIOClientPrivilegeAdministrator) != kIOReturnSuccess) { return false; }
+    return IOUserClient::initWithTask(owningTask, securityToken, type, properties);
+}
+
+// Also reached through `clientDied`, so a crashed client can't keep GC out of GFXOFF.
+IOReturn NRedPerfCounterClient::clientClose()
+{
+    PerfCounters::singleton().abortSession(this);
+    this->terminate();
+    return kIOReturnSuccess;
+}
+
+IOReturn NRedPerfCounterClient::externalMethod(const uint32_t selector, IOExternalMethodArguments* const arguments,
+                                               IOExternalMethodDispatch*, OSObject*, void*)
+{
+    if (selector >= static_cast<UInt32>(PerfCounterSelector::Count)) { return kIOReturnBadArgument; }
+    return IOUserClient::externalMethod(selector, arguments, const_cast<IOExternalMethodDispatch*>(&methods[selector]),
+                                        this, nullptr);
+}
+
+IOReturn NRedPerfCounterClient::beginSession(OSObject* const target, void*, IOExternalMethodArguments* const arguments)
+{
+    if (arguments->scalarInputCount == 0) { return PerfCounters::singleton().beginSession(target, nullptr, 0); }
+    if (arguments->scalarInputCount != PERF_COUNTER_SLOTS) { return kIOReturnBadArgument; }
+
+    UInt32 events[PERF_COUNTER_SLOTS];
+    for (size_t i = 0; i < PERF_COUNTER_SLOTS; i += 1) {
+        if (arguments->scalarInput[i] > PERF_COUNTER_NO_EVENT) { return kIOReturnBadArgument; }
+        events[i] = static_cast<UInt32>(arguments->scalarInput[i]);
+    }
+    return PerfCounters::singleton().beginSession(target, events, PERF_COUNTER_SLOTS);
+}
+
+IOReturn NRedPerfCounterClient::endSession(OSObject* const target, void*, IOExternalMethodArguments* const arguments)
+{
+    UInt64     values[PERF_COUNTER_SLOTS];
+    const auto ret = PerfCounters::singleton().endSession(target, values);
+    if (ret != kIOReturnSuccess) { return ret; }
+    for (size_t i = 0; i < PERF_COUNTER_SLOTS; i += 1) { arguments->scalarOutput[i] = values[i]; }
+    return kIOReturnSuccess;
+}
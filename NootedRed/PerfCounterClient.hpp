@@ -0,0 +1,32 @@
+// Performance Counter User Client
+// Lets an administrator bracket a submission with a `PerfCounters` session, created through `IOUserClientClass`.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOUserClient.h>
+
+enum struct PerfCounterSelector : UInt32
+{
+    BeginSession,    // No inputs for the `NRedPerf<name>` defaults, or one event per catalog slot.
+    EndSession,      // One output per catalog slot.
+    Count,
+};
+
+class NRedPerfCounterClient : public IOUserClient
+{
+    OSDeclareDefaultStructors(NRedPerfCounterClient);
+
+    static const IOExternalMethodDispatch methods[static_cast<UInt32>(PerfCounterSelector::Count)];
+
+public:
+    bool     initWithTask(task_t owningTask, void* securityToken, UInt32 type, OSDictionary* properties) override;
+    IOReturn clientClose() override;
+    IOReturn externalMethod(uint32_t selector, IOExternalMethodArguments* arguments, IOExternalMethodDispatch* dispatch,
+                            OSObject* target, void* reference) override;
+
+private:
+    static IOReturn beginSession(OSObject* target, void* reference, IOExternalMethodArguments* arguments);
+    static IOReturn endSession(OSObject* target, void* reference, IOExternalMethodArguments* arguments);
+};
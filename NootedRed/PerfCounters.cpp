@@ -0,0 +1,201 @@
+// Performance Counters
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <GPUDriversAMD/RavenIPOffset.hpp>
+#include <GfxOff.hpp>
+#include <NRed.hpp>
+#include <PerfCounters.hpp>
+#include <libkern/c++/OSDictionary.h>
+#include <libkern/c++/OSNumber.h>
+#include <pexpert/pexpert.h>
+
+static_assert(isValidPerfCatalog(kGC9PerfCounters));
+static_assert(encodePerfSelect(kGC9PerfCounters[0], GRBM_PERF_SEL_GUI_ACTIVE) == 0x2);
+static_assert(encodePerfSelect(kGC9PerfCounters[1], SQ_PERF_SEL_WAVES) == 0x0F0FF004);
+static_assert(encodePerfSelect(kGC9PerfCounters[1], 0x1FF) == 0x0F0FF1FF);
+static_assert(isValidPerfEvent(kGC9PerfCounters[2], 0xFF));
+static_assert(!isValidPerfEvent(kGC9PerfCounters[2], 0x100));
+static_assert(!isValidPerfEvent(kGC9PerfCounters[2], PERF_COUNTER_NO_EVENT));
+
+static constexpr PerfCounterSlot kSharedSelect[] = {
+    {"A", GRBM_PERFCOUNTER0_SELECT, GRBM_PERFCOUNTER0_LO, GRBM_PERFCOUNTER0_HI, 0x3F, 0, PERF_COUNTER_NO_EVENT},
+    {"B", GRBM_PERFCOUNTER0_SELECT, SQ_PERFCOUNTER0_LO, SQ_PERFCOUNTER0_HI, 0x3F, 0, PERF_COUNTER_NO_EVENT},
+};
+static constexpr PerfCounterSlot kSwappedRanges[] = {
+    {"A", GRBM_PERFCOUNTER0_LO, GRBM_PERFCOUNTER0_SELECT, GRBM_PERFCOUNTER0_SELECT + 1, 0x3F, 0, PERF_COUNTER_NO_EVENT},
+};
+static constexpr PerfCounterSlot kFixedBitsInEvent[] = {
+    {"A", GRBM_PERFCOUNTER0_SELECT, GRBM_PERFCOUNTER0_LO, GRBM_PERFCOUNTER0_HI, 0x3F, 0x1, PERF_COUNTER_NO_EVENT},
+};
+static constexpr PerfCounterSlot kBadDefault[] = {
+    {"A", GRBM_PERFCOUNTER0_SELECT, GRBM_PERFCOUNTER0_LO, GRBM_PERFCOUNTER0_HI, 0x3F, 0, 0x40},
+};
+
+static_assert(!isValidPerfCatalog(kSharedSelect));
+static_assert(!isValidPerfCatalog(kSwappedRanges));
+static_assert(!isValidPerfCatalog(kFixedBitsInEvent));
+static_assert(!isValidPerfCatalog(kBadDefault));
+
+static PerfCounters moduleInstance;
+
+PerfCounters& PerfCounters::singleton() { return moduleInstance; }
+
+void PerfCounters::init()
+{
+    if (this->lock != nullptr || !checkKernelArgument("-NRedPerfCounters")) { return; }
+
+    char key[32];
+    for (size_t i = 0; i < PERF_COUNTER_SLOTS; i += 1) {
+        const auto& slot       = kGC9PerfCounters[i];
+        this->defaultEvents[i] = slot.defaultEvent;
+        snprintf(key, arrsize(key), "NRedPerf%s", slot.name);
+        UInt32 event;
+        if (!PE_parse_boot_argn(key, &event, sizeof(event))) { continue; }
+        if (isValidPerfEvent(slot, event)) { this->defaultEvents[i] = event; }
+        else {
+            SYSLOG("PerfCounters", "Ignoring invalid %s event 0x%X", slot.name, event);
+        }
+    }
+
+    this->lock = IOLockAlloc();
+    PANIC_COND(this->lock == nullptr, "PerfCounters", "Failed to allocate lock");
+    SYSLOG("PerfCounters", "Enabled");
+}
+
+void PerfCounters::start()
+{
+    if (this->lock == nullptr) { return; }
+
+    IOLockLock(this->lock);
+    this->powered = true;
+    IOLockUnlock(this->lock);
+}
+
+// GC loses the selects across power cycles, so a session can't survive one.
+void PerfCounters::stop()
+{
+    if (this->lock == nullptr) { return; }
+
+    IOLockLock(this->lock);
+    this->powered        = false;
+    const bool hadActive = this->owner != nullptr && !this->aborted;
+    if (hadActive) { this->aborted = true; }
+    IOLockUnlock(this->lock);
+    if (hadActive) { GfxOff::singleton().put(); }
+}
+
+IOReturn PerfCounters::beginSession(const void* const owner, const UInt32* const events, const size_t count)
+{
+    if (this->lock == nullptr) { return kIOReturnUnsupported; }
+    if (events != nullptr && count != PERF_COUNTER_SLOTS) { return kIOReturnBadArgument; }
+    for (size_t i = 0; events != nullptr && i < PERF_COUNTER_SLOTS; i += 1) {
+        if (events[i] != PERF_COUNTER_NO_EVENT && !isValidPerfEvent(kGC9PerfCounters[i], events[i])) {
+            return kIOReturnBadArgument;
+        }
+    }
+
+    IOLockLock(this->lock);
+    if (this->owner != nullptr) {
+        IOLockUnlock(this->lock);
+        return kIOReturnBusy;
+    }
+    if (!this->powered) {
+        IOLockUnlock(this->lock);
+        return kIOReturnNotReady;
+    }
+    this->owner   = owner;
+    this->aborted = false;
+    for (size_t i = 0; i < PERF_COUNTER_SLOTS; i += 1) {
+        this->events[i] = events == nullptr ? this->defaultEvents[i] : events[i];
+    }
+    GfxOff::singleton().get();
+    this->programLocked();
+    IOLockUnlock(this->lock);
+    return kIOReturnSuccess;
+}
+
+IOReturn PerfCounters::endSession(const void* const owner, UInt64 (&values)[PERF_COUNTER_SLOTS])
+{
+    if (this->lock == nullptr) { return kIOReturnUnsupported; }
+
+    IOLockLock(this->lock);
+    if (this->owner != owner || owner == nullptr) {
+        IOLockUnlock(this->lock);
+        return kIOReturnNotOpen;
+    }
+    this->owner = nullptr;
+    if (this->aborted) {
+        IOLockUnlock(this->lock);
+        return kIOReturnAborted;
+    }
+    this->readLocked(values);
+    this->publishLocked(values);
+    IOLockUnlock(this->lock);
+    GfxOff::singleton().put();
+    return kIOReturnSuccess;
+}
+
+void PerfCounters::abortSession(const void* const owner)
+{
+    if (this->lock == nullptr) { return; }
+
+    IOLockLock(this->lock);
+    if (this->owner != owner || owner == nullptr) {
+        IOLockUnlock(this->lock);
+        return;
+    }
+    this->owner        = nullptr;
+    const bool release = !this->aborted;
+    if (release) {
+        NRed::singleton().writeReg32(GC_BASE_1 + CP_PERFMON_CNTL, CP_PERFMON_CNTL_PERFMON_STATE_DISABLE_AND_RESET);
+    }
+    IOLockUnlock(this->lock);
+    if (release) { GfxOff::singleton().put(); }
+}
+
+void PerfCounters::programLocked()
+{
+    const auto& nred = NRed::singleton();
+    nred.writeReg32(GC_BASE_1 + CP_PERFMON_CNTL, CP_PERFMON_CNTL_PERFMON_STATE_DISABLE_AND_RESET);
+    nred.writeReg32(GC_BASE_1 + SQ_PERFCOUNTER_CTRL, SQ_PERFCOUNTER_CTRL_ALL_STAGES);
+    for (size_t i = 0; i < PERF_COUNTER_SLOTS; i += 1) {
+        if (this->events[i] == PERF_COUNTER_NO_EVENT) { continue; }
+        const auto& slot = kGC9PerfCounters[i];
+        nred.writeReg32(GC_BASE_1 + slot.select, encodePerfSelect(slot, this->events[i]));
+    }
+    nred.writeReg32(GC_BASE_1 + CP_PERFMON_CNTL, CP_PERFMON_CNTL_PERFMON_STATE_START_COUNTING);
+}
+
+// Counters are read with GRBM_GFX_INDEX on broadcast, so the per-instance blocks report their first instance.
+void PerfCounters::readLocked(UInt64 (&values)[PERF_COUNTER_SLOTS])
+{
+    const auto& nred = NRed::singleton();
+    nred.writeReg32(GC_BASE_1 + CP_PERFMON_CNTL, CP_PERFMON_CNTL_PERFMON_STATE_STOP_COUNTING);
+    for (size_t i = 0; i < PERF_COUNTER_SLOTS; i += 1) {
+        if (this->events[i] == PERF_COUNTER_NO_EVENT) {
+            values[i] = 0;
+            continue;
+        }
+        const auto& slot = kGC9PerfCounters[i];
+        values[i]        = nred.readReg32(GC_BASE_1 + slot.lo)
+                    | (static_cast<UInt64>(nred.readReg32(GC_BASE_1 + slot.hi)) << 32);
+    }
+    nred.writeReg32(GC_BASE_1 + CP_PERFMON_CNTL, CP_PERFMON_CNTL_PERFMON_STATE_DISABLE_AND_RESET);
+}
+
+void PerfCounters::publishLocked(const UInt64 (&values)[PERF_COUNTER_SLOTS])
+{
+    auto* const dict = OSDictionary::withCapacity(PERF_COUNTER_SLOTS);
+    if (dict == nullptr) { return; }
+    for (size_t i = 0; i < PERF_COUNTER_SLOTS; i += 1) {
+        if (this->events[i] == PERF_COUNTER_NO_EVENT) { continue; }
+        auto* const num = OSNumber::withNumber(values[i], 64);
+        if (num == nullptr) { continue; }
+        dict->setObject(kGC9PerfCounters[i].name, num);
+        num->release();
+    }
+    NRed::singleton().setProp("NRedPerfCounters", dict);
+    dict->release();
+}
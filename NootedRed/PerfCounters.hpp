@@ -0,0 +1,101 @@
+// Performance Counters
+// Programs one GFX9 perf counter per block from a catalog and reads them back around a user client's session.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <Headers/kern_util.hpp>
+#include <IOKit/IOLocks.h>
+#include <IOKit/IOTypes.h>
+#include <Regs/GC.hpp>
+
+struct PerfCounterSlot
+{
+    const char* name;            // Also the suffix of the `NRedPerf<name>=<event>` boot argument.
+    UInt32      select;          // All GC_BASE_1 relative.
+    UInt32      lo;
+    UInt32      hi;
+    UInt32      eventMask;       // The `PERF_SEL` field.
+    UInt32      fixedBits;       // Always set in the select value, e.g. the SQ SIMD mask.
+    UInt32      defaultEvent;    // `PERF_COUNTER_NO_EVENT` for none.
+};
+
+constexpr UInt32 PERF_COUNTER_NO_EVENT = 0xFFFFFFFF;
+
+constexpr UInt32 GRBM_PERF_SEL_GUI_ACTIVE = 2;
+constexpr UInt32 SQ_PERF_SEL_WAVES        = 4;
+
+// The layout is the same on GC 9.1, 9.2 and 9.3, so Raven, Picasso, Raven2 and Renoir share the catalog.
+constexpr PerfCounterSlot kGC9PerfCounters[] = {
+    {"GRBM", GRBM_PERFCOUNTER0_SELECT, GRBM_PERFCOUNTER0_LO, GRBM_PERFCOUNTER0_HI, 0x3F, 0, GRBM_PERF_SEL_GUI_ACTIVE},
+    {"SQ", SQ_PERFCOUNTER0_SELECT, SQ_PERFCOUNTER0_LO, SQ_PERFCOUNTER0_HI, 0x1FF,
+     SQ_PERFCOUNTER0_SELECT_SQC_BANK_MASK | SQ_PERFCOUNTER0_SELECT_SQC_CLIENT_MASK | SQ_PERFCOUNTER0_SELECT_SIMD_MASK,
+     SQ_PERF_SEL_WAVES},
+    {"TA", TA_PERFCOUNTER0_SELECT, TA_PERFCOUNTER0_LO, TA_PERFCOUNTER0_HI, 0xFF, 0, PERF_COUNTER_NO_EVENT},
+    {"TCC", TCC_PERFCOUNTER0_SELECT, TCC_PERFCOUNTER0_LO, TCC_PERFCOUNTER0_HI, 0x3FF, 0, PERF_COUNTER_NO_EVENT},
+    {"DB", DB_PERFCOUNTER0_SELECT, DB_PERFCOUNTER0_LO, DB_PERFCOUNTER0_HI, 0x3FF, 0, PERF_COUNTER_NO_EVENT},
+    {"CB", CB_PERFCOUNTER0_SELECT, CB_PERFCOUNTER0_LO, CB_PERFCOUNTER0_HI, 0x1FF, 0, PERF_COUNTER_NO_EVENT},
+};
+
+constexpr size_t PERF_COUNTER_SLOTS = arrsize(kGC9PerfCounters);
+
+constexpr bool isValidPerfEvent(const PerfCounterSlot& slot, const UInt32 event)
+{ return event != PERF_COUNTER_NO_EVENT && (event & ~slot.eventMask) == 0; }
+
+constexpr UInt32 encodePerfSelect(const PerfCounterSlot& slot, const UInt32 event)
+{ return (event & slot.eventMask) | slot.fixedBits; }
+
+// Counters live in the uconfig counter range and their selects in the select range, every register used once.
+template<size_t N>
+constexpr bool isValidPerfCatalog(const PerfCounterSlot (&catalog)[N])
+{
+    for (size_t i = 0; i < N; i += 1) {
+        const auto& slot = catalog[i];
+        if (slot.lo < GC_PERFCOUNTER_START || slot.hi != slot.lo + 1 || slot.hi >= GC_PERFCOUNTER_SELECT_START
+            || slot.select < GC_PERFCOUNTER_SELECT_START || slot.select > GC_PERFCOUNTER_SELECT_END
+            || slot.eventMask == 0 || (slot.fixedBits & slot.eventMask) != 0
+            || (slot.defaultEvent != PERF_COUNTER_NO_EVENT && !isValidPerfEvent(slot, slot.defaultEvent)))
+        {
+            return false;
+        }
+        for (size_t j = 0; j < i; j += 1) {
+            const auto& other = catalog[j];
+            if (other.select == slot.select || other.lo == slot.lo || other.lo == slot.hi || other.hi == slot.lo) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+class PerfCounters
+{
+    IOLock*     lock{nullptr};
+    const void* owner{nullptr};    // The client running the session, if any.
+    UInt32      defaultEvents[PERF_COUNTER_SLOTS]{};
+    UInt32      events[PERF_COUNTER_SLOTS]{};
+    bool        powered{false};
+    bool        aborted{false};    // The session outlived the SMU.
+
+public:
+    static PerfCounters& singleton();
+
+    // Opt-in through `-NRedPerfCounters`, sessions fail with `kIOReturnUnsupported` otherwise.
+    void init();
+    // Has to come after `GfxOff::start`. A power-down ends the running session, its `endSession` then fails.
+    void start();
+    void stop();
+
+    // `events` holds one event per catalog slot, `nullptr` keeps the `NRedPerf<name>` defaults.
+    // GC is kept out of GFXOFF from `beginSession` until the session ends, otherwise the counters would be lost.
+    IOReturn beginSession(const void* owner, const UInt32* events, size_t count);
+    // `values` gets one value per catalog slot, zero for slots without an event. Also published as `NRedPerfCounters`.
+    IOReturn endSession(const void* owner, UInt64 (&values)[PERF_COUNTER_SLOTS]);
+    void     abortSession(const void* owner);
+
+private:
+    void programLocked();
+    void readLocked(UInt64 (&values)[PERF_COUNTER_SLOTS]);
+    void publishLocked(const UInt64 (&values)[PERF_COUNTER_SLOTS]);
+};
@@ -83,3 +83,122 @@ constexpr UInt32 CB_HW_CONTROL_2                            = 0x682;
 constexpr UInt32 CB_HW_CONTROL_2_BASE_IDX                   = 0;
 constexpr UInt32 GCEA_SDP_BACKDOOR_DATACREDITS0             = 0x711;
 constexpr UInt32 GCEA_SDP_BACKDOOR_DATACREDITS0_BASE_IDX    = 0;
+constexpr UInt32 CP_MEM_SLP_CNTL                            = 0x1079;
+constexpr UInt32 CP_MEM_SLP_CNTL_BASE_IDX                   = 0;
+constexpr UInt32 CP_RB_WPTR_POLL_CNTL                       = 0x1083;
+constexpr UInt32 CP_RB_WPTR_POLL_CNTL_BASE_IDX              = 0;
+constexpr UInt32 CP_RB0_RPTR                                = 0x10C0;
+constexpr UInt32 CP_RB0_RPTR_BASE_IDX                       = 0;
+constexpr UInt32 CP_RB0_WPTR                                = 0x1DF4;
+constexpr UInt32 CP_RB0_WPTR_BASE_IDX                       = 0;
+constexpr UInt32 RLC_CNTL                                   = 0x4C00;
+constexpr UInt32 RLC_CNTL_BASE_IDX                          = 1;
+constexpr UInt32 RLC_SAFE_MODE                              = 0x4C05;
+constexpr UInt32 RLC_SAFE_MODE_BASE_IDX                     = 1;
+constexpr UInt32 RLC_MEM_SLP_CNTL                           = 0x4C06;
+constexpr UInt32 RLC_MEM_SLP_CNTL_BASE_IDX                  = 1;
+constexpr UInt32 RLC_CGTT_MGCG_OVERRIDE                     = 0x4C48;
+constexpr UInt32 RLC_CGTT_MGCG_OVERRIDE_BASE_IDX            = 1;
+constexpr UInt32 RLC_CGCG_CGLS_CTRL                         = 0x4C49;
+constexpr UInt32 RLC_CGCG_CGLS_CTRL_BASE_IDX                = 1;
+constexpr UInt32 RLC_LB_ALWAYS_ACTIVE_CU_MASK               = 0x4C50;
+constexpr UInt32 RLC_LB_ALWAYS_ACTIVE_CU_MASK_BASE_IDX      = 1;
+constexpr UInt32 GRBM_GFX_INDEX                             = 0x2200;
+constexpr UInt32 GRBM_GFX_INDEX_BASE_IDX                    = 1;
+constexpr UInt32 CC_GC_SHADER_ARRAY_CONFIG                  = 0x226F;
+constexpr UInt32 CC_GC_SHADER_ARRAY_CONFIG_BASE_IDX         = 1;
+constexpr UInt32 GC_USER_SHADER_ARRAY_CONFIG                = 0x2270;
+constexpr UInt32 GC_USER_SHADER_ARRAY_CONFIG_BASE_IDX       = 1;
+constexpr UInt32 GRBM_STATUS2                               = 0xDA2;
+constexpr UInt32 GRBM_STATUS2_BASE_IDX                      = 0;
+constexpr UInt32 GRBM_STATUS                                = 0xDA4;
+constexpr UInt32 GRBM_STATUS_BASE_IDX                       = 0;
+constexpr UInt32 GRBM_STATUS_SE0                            = 0xDA5;
+constexpr UInt32 GRBM_STATUS_SE0_BASE_IDX                   = 0;
+constexpr UInt32 GRBM_PERFCOUNTER0_LO                       = 0x3040;
+constexpr UInt32 GRBM_PERFCOUNTER0_LO_BASE_IDX              = 1;
+constexpr UInt32 GRBM_PERFCOUNTER0_HI                       = 0x3041;
+constexpr UInt32 GRBM_PERFCOUNTER0_HI_BASE_IDX              = 1;
+constexpr UInt32 SQ_PERFCOUNTER0_LO                         = 0x31C0;
+constexpr UInt32 SQ_PERFCOUNTER0_LO_BASE_IDX                = 1;
+constexpr UInt32 SQ_PERFCOUNTER0_HI                         = 0x31C1;
+constexpr UInt32 SQ_PERFCOUNTER0_HI_BASE_IDX                = 1;
+constexpr UInt32 TA_PERFCOUNTER0_LO                         = 0x32C0;
+constexpr UInt32 TA_PERFCOUNTER0_LO_BASE_IDX                = 1;
+constexpr UInt32 TA_PERFCOUNTER0_HI                         = 0x32C1;
+constexpr UInt32 TA_PERFCOUNTER0_HI_BASE_IDX                = 1;
+constexpr UInt32 TCC_PERFCOUNTER0_LO                        = 0x3380;
+constexpr UInt32 TCC_PERFCOUNTER0_LO_BASE_IDX               = 1;
+constexpr UInt32 TCC_PERFCOUNTER0_HI                        = 0x3381;
+constexpr UInt32 TCC_PERFCOUNTER0_HI_BASE_IDX               = 1;
+constexpr UInt32 CB_PERFCOUNTER0_LO                         = 0x3406;
+constexpr UInt32 CB_PERFCOUNTER0_LO_BASE_IDX                = 1;
+constexpr UInt32 CB_PERFCOUNTER0_HI                         = 0x3407;
+constexpr UInt32 CB_PERFCOUNTER0_HI_BASE_IDX                = 1;
+constexpr UInt32 DB_PERFCOUNTER0_LO                         = 0x3440;
+constexpr UInt32 DB_PERFCOUNTER0_LO_BASE_IDX                = 1;
+constexpr UInt32 DB_PERFCOUNTER0_HI                         = 0x3441;
+constexpr UInt32 DB_PERFCOUNTER0_HI_BASE_IDX                = 1;
+constexpr UInt32 CP_PERFMON_CNTL                            = 0x3808;
+constexpr UInt32 CP_PERFMON_CNTL_BASE_IDX                   = 1;
+constexpr UInt32 GRBM_PERFCOUNTER0_SELECT                   = 0x3840;
+constexpr UInt32 GRBM_PERFCOUNTER0_SELECT_BASE_IDX          = 1;
+constexpr UInt32 SQ_PERFCOUNTER0_SELECT                     = 0x39C0;
+constexpr UInt32 SQ_PERFCOUNTER0_SELECT_BASE_IDX            = 1;
+constexpr UInt32 SQ_PERFCOUNTER_CTRL                        = 0x39E0;
+constexpr UInt32 SQ_PERFCOUNTER_CTRL_BASE_IDX               = 1;
+constexpr UInt32 TA_PERFCOUNTER0_SELECT                     = 0x3AC0;
+constexpr UInt32 TA_PERFCOUNTER0_SELECT_BASE_IDX            = 1;
+constexpr UInt32 TCC_PERFCOUNTER0_SELECT                    = 0x3B80;
+constexpr UInt32 TCC_PERFCOUNTER0_SELECT_BASE_IDX           = 1;
+constexpr UInt32 CB_PERFCOUNTER0_SELECT                     = 0x3C01;
+constexpr UInt32 CB_PERFCOUNTER0_SELECT_BASE_IDX            = 1;
+constexpr UInt32 DB_PERFCOUNTER0_SELECT                     = 0x3C40;
+constexpr UInt32 DB_PERFCOUNTER0_SELECT_BASE_IDX            = 1;
+
+constexpr UInt32 RLC_CNTL_RLC_ENABLE_F32                            = 0x1;
+constexpr UInt32 CP_MEM_SLP_CNTL_CP_MEM_LS_EN                      = 0x1;
+constexpr UInt32 RLC_MEM_SLP_CNTL_RLC_MEM_LS_EN                    = 0x1;
+constexpr UInt32 RLC_SAFE_MODE_CMD                                 = 0x1;
+constexpr UInt32 RLC_SAFE_MODE_MESSAGE_ENTER                       = 0x2;
+constexpr UInt32 RLC_CGTT_MGCG_OVERRIDE_CPF_CGTT_SCLK_OVERRIDE     = 0x1;
+constexpr UInt32 RLC_CGTT_MGCG_OVERRIDE_RLC_CGTT_SCLK_OVERRIDE     = 0x2;
+constexpr UInt32 RLC_CGTT_MGCG_OVERRIDE_GFXIP_MGCG_OVERRIDE        = 0x4;
+constexpr UInt32 RLC_CGTT_MGCG_OVERRIDE_GFXIP_CGCG_OVERRIDE        = 0x8;
+constexpr UInt32 RLC_CGTT_MGCG_OVERRIDE_GFXIP_CGLS_OVERRIDE        = 0x10;
+constexpr UInt32 RLC_CGTT_MGCG_OVERRIDE_GRBM_CGTT_SCLK_OVERRIDE    = 0x20;
+constexpr UInt32 RLC_CGTT_MGCG_OVERRIDE_GFXIP_MGLS_OVERRIDE        = 0x40;
+constexpr UInt32 RLC_CGCG_CGLS_CTRL_CGCG_EN                        = 0x1;
+constexpr UInt32 RLC_CGCG_CGLS_CTRL_CGLS_EN                        = 0x2;
+constexpr UInt32 RLC_CGCG_CGLS_CTRL_CGLS_REP_COMPANSAT_DELAY_SHIFT = 2;
+constexpr UInt32 RLC_CGCG_CGLS_CTRL_CGCG_GFX_IDLE_THRESHOLD_SHIFT  = 8;
+constexpr UInt32 CP_RB_WPTR_POLL_CNTL_POLL_FREQUENCY_SHIFT         = 0;
+constexpr UInt32 CP_RB_WPTR_POLL_CNTL_IDLE_POLL_COUNT_SHIFT        = 16;
+constexpr UInt32 CP_RB_WPTR_POLL_CNTL_POLL_FREQUENCY_MASK          = 0xFFFF;
+constexpr UInt32 CP_RB_WPTR_POLL_CNTL_IDLE_POLL_COUNT_MASK         = 0xFFFF0000;
+constexpr UInt32 GRBM_GFX_INDEX_SH_INDEX_SHIFT                     = 8;
+constexpr UInt32 GRBM_GFX_INDEX_SE_INDEX_SHIFT                     = 16;
+constexpr UInt32 GRBM_GFX_INDEX_SH_BROADCAST_WRITES                = 0x20000000;
+constexpr UInt32 GRBM_GFX_INDEX_INSTANCE_BROADCAST_WRITES          = 0x40000000;
+constexpr UInt32 GRBM_GFX_INDEX_SE_BROADCAST_WRITES                = 0x80000000;
+constexpr UInt32 CC_GC_SHADER_ARRAY_CONFIG_INACTIVE_CUS_MASK       = 0xFFFF0000;
+constexpr UInt32 CC_GC_SHADER_ARRAY_CONFIG_INACTIVE_CUS_SHIFT      = 16;
+constexpr UInt32 GRBM_STATUS_TA_BUSY                               = 0x4000;
+constexpr UInt32 GRBM_STATUS_DB_BUSY                               = 0x4000000;
+constexpr UInt32 GRBM_STATUS_CP_COHERENCY_BUSY                     = 0x10000000;
+constexpr UInt32 GRBM_STATUS_CP_BUSY                               = 0x20000000;
+constexpr UInt32 GRBM_STATUS_GUI_ACTIVE                            = 0x80000000;
+constexpr UInt32 GRBM_STATUS_SE0_TA_BUSY                           = 0x2000000;
+constexpr UInt32 GRBM_STATUS_SE0_DB_BUSY                           = 0x40000000;
+constexpr UInt32 CP_PERFMON_CNTL_PERFMON_STATE_DISABLE_AND_RESET   = 0x0;
+constexpr UInt32 CP_PERFMON_CNTL_PERFMON_STATE_START_COUNTING      = 0x1;
+constexpr UInt32 CP_PERFMON_CNTL_PERFMON_STATE_STOP_COUNTING       = 0x2;
+constexpr UInt32 SQ_PERFCOUNTER0_SELECT_SQC_BANK_MASK              = 0xF000;
+constexpr UInt32 SQ_PERFCOUNTER0_SELECT_SQC_CLIENT_MASK            = 0xF0000;
+constexpr UInt32 SQ_PERFCOUNTER0_SELECT_SIMD_MASK                  = 0xF000000;
+constexpr UInt32 SQ_PERFCOUNTER_CTRL_ALL_STAGES                    = 0x7F;
+
+// GC_BASE_1 relative ranges of the uconfig performance counters and their selects.
+constexpr UInt32 GC_PERFCOUNTER_START        = 0x3000;
+constexpr UInt32 GC_PERFCOUNTER_SELECT_START = 0x3800;
+constexpr UInt32 GC_PERFCOUNTER_SELECT_END   = 0x3FFF;
@@ -0,0 +1,19 @@
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOTypes.h>
+
+constexpr UInt32 ATC_L2_MISC_CG          = 0x64A;
+constexpr UInt32 ATC_L2_MISC_CG_BASE_IDX = 0;
+constexpr UInt32 MC_VM_AGP_TOP           = 0x856;
+constexpr UInt32 MC_VM_AGP_TOP_BASE_IDX  = 0;
+constexpr UInt32 MC_VM_AGP_BOT           = 0x857;
+constexpr UInt32 MC_VM_AGP_BOT_BASE_IDX  = 0;
+constexpr UInt32 MC_VM_AGP_BASE          = 0x858;
+constexpr UInt32 MC_VM_AGP_BASE_BASE_IDX = 0;
+
+constexpr UInt32 ATC_L2_MISC_CG_ENABLE        = 0x40000;
+constexpr UInt32 ATC_L2_MISC_CG_MEM_LS_ENABLE = 0x80000;
+constexpr UInt32 MC_VM_AGP_ADDR_MASK          = 0xFFFFFF;    // In 16MiB units.
+constexpr UInt32 MC_VM_AGP_ADDR_SHIFT         = 24;
@@ -9,30 +9,58 @@ constexpr UInt32 SDMA0_CLK_CTRL               = 0x1B;
 constexpr UInt32 SDMA0_CHICKEN_BITS           = 0x1D;
 constexpr UInt32 SDMA0_GB_ADDR_CONFIG         = 0x1E;
 constexpr UInt32 SDMA0_GB_ADDR_CONFIG_READ    = 0x1F;
+constexpr UInt32 SDMA0_STATUS_REG             = 0x25;
 constexpr UInt32 SDMA0_F32_CNTL               = 0x2A;
 constexpr UInt32 SDMA0_UTCL1_WATERMK          = 0x3D;
 constexpr UInt32 SDMA0_UTCL1_PAGE             = 0x48;
+constexpr UInt32 SDMA0_GFX_RB_RPTR            = 0x83;
+constexpr UInt32 SDMA0_GFX_RB_WPTR            = 0x85;
 constexpr UInt32 SDMA0_GFX_RB_WPTR_POLL_CNTL  = 0x87;
 constexpr UInt32 SDMA0_GFX_IB_CNTL            = 0x8A;
 constexpr UInt32 SDMA0_GFX_MINOR_PTR_UPDATE   = 0xB5;
 constexpr UInt32 SDMA0_RLC0_RB_WPTR_POLL_CNTL = 0x147;
 constexpr UInt32 SDMA0_RLC0_IB_CNTL           = 0x14A;
+constexpr UInt32 SDMA0_RLC1_RB_CNTL           = 0x1A0;
+constexpr UInt32 SDMA0_RLC1_RB_BASE           = 0x1A1;
+constexpr UInt32 SDMA0_RLC1_RB_BASE_HI        = 0x1A2;
+constexpr UInt32 SDMA0_RLC1_RB_RPTR           = 0x1A3;
+constexpr UInt32 SDMA0_RLC1_RB_RPTR_HI        = 0x1A4;
+constexpr UInt32 SDMA0_RLC1_RB_WPTR           = 0x1A5;
+constexpr UInt32 SDMA0_RLC1_RB_WPTR_HI        = 0x1A6;
 constexpr UInt32 SDMA0_RLC1_RB_WPTR_POLL_CNTL = 0x1A7;
 constexpr UInt32 SDMA0_RLC1_IB_CNTL           = 0x1AA;
+constexpr UInt32 SDMA0_RLC1_MINOR_PTR_UPDATE  = 0x1D5;
 
-constexpr UInt32 SDMA0_F32_CNTL_HALT = 0x1;
+constexpr UInt32 SDMA0_F32_CNTL_HALT                 = 0x1;
+constexpr UInt32 SDMA0_STATUS_REG_IDLE               = 0x1;
+constexpr UInt32 SDMA0_POWER_CNTL_MEM_POWER_OVERRIDE = 0x100;
+constexpr UInt32 SDMA0_CLK_CTRL_SOFT_OVERRIDE_ALL    = 0xFF000000;
+constexpr UInt32 SDMA0_RLC_RB_CNTL_RB_ENABLE         = 0x1;
+constexpr UInt32 SDMA0_RLC_RB_CNTL_RB_SIZE_SHIFT     = 1;    // log2 of the size in dwords.
+constexpr UInt32 SDMA0_RLC_RB_CNTL_RB_VMID_SHIFT     = 24;
 
 constexpr UInt32 SDMA0_POWER_CNTL_BASE_IDX             = 0;
 constexpr UInt32 SDMA0_CLK_CTRL_BASE_IDX               = 0;
 constexpr UInt32 SDMA0_CHICKEN_BITS_BASE_IDX           = 0;
 constexpr UInt32 SDMA0_GB_ADDR_CONFIG_BASE_IDX         = 0;
 constexpr UInt32 SDMA0_GB_ADDR_CONFIG_READ_BASE_IDX    = 0;
+constexpr UInt32 SDMA0_STATUS_REG_BASE_IDX             = 0;
 constexpr UInt32 SDMA0_UTCL1_WATERMK_BASE_IDX          = 0;
 constexpr UInt32 SDMA0_UTCL1_PAGE_BASE_IDX             = 0;
+constexpr UInt32 SDMA0_GFX_RB_RPTR_BASE_IDX            = 0;
+constexpr UInt32 SDMA0_GFX_RB_WPTR_BASE_IDX            = 0;
 constexpr UInt32 SDMA0_GFX_RB_WPTR_POLL_CNTL_BASE_IDX  = 0;
 constexpr UInt32 SDMA0_GFX_IB_CNTL_BASE_IDX            = 0;
 constexpr UInt32 SDMA0_GFX_MINOR_PTR_UPDATE_BASE_IDX   = 0;
 constexpr UInt32 SDMA0_RLC0_RB_WPTR_POLL_CNTL_BASE_IDX = 0;
 constexpr UInt32 SDMA0_RLC0_IB_CNTL_BASE_IDX           = 0;
+constexpr UInt32 SDMA0_RLC1_RB_CNTL_BASE_IDX           = 0;
+constexpr UInt32 SDMA0_RLC1_RB_BASE_BASE_IDX           = 0;
+constexpr UInt32 SDMA0_RLC1_RB_BASE_HI_BASE_IDX        = 0;
+constexpr UInt32 SDMA0_RLC1_RB_RPTR_BASE_IDX           = 0;
+constexpr UInt32 SDMA0_RLC1_RB_RPTR_HI_BASE_IDX        = 0;
+constexpr UInt32 SDMA0_RLC1_RB_WPTR_BASE_IDX           = 0;
+constexpr UInt32 SDMA0_RLC1_RB_WPTR_HI_BASE_IDX        = 0;
 constexpr UInt32 SDMA0_RLC1_RB_WPTR_POLL_CNTL_BASE_IDX = 0;
 constexpr UInt32 SDMA0_RLC1_IB_CNTL_BASE_IDX           = 0;
+constexpr UInt32 SDMA0_RLC1_MINOR_PTR_UPDATE_BASE_IDX  = 0;
@@ -15,3 +15,10 @@ constexpr UInt32 MP1_SMN_C2PMSG_90                     = 0x29A;
 constexpr UInt32 MP1_SMN_FPS_CNT                       = 0x2C4;
 constexpr UInt32 MP1_FIRMWARE_FLAGS                    = 0x3010024;
 constexpr UInt32 MP1_FIRMWARE_FLAGS_INTERRUPTS_ENABLED = 0x1;
+
+// What the SMU leaves in `MP1_SMN_C2PMSG_90` once it has handled a message.
+constexpr UInt32 SMU_RESPONSE_OK              = 0x1;
+constexpr UInt32 SMU_RESPONSE_FAILED          = 0xFF;
+constexpr UInt32 SMU_RESPONSE_UNKNOWN_COMMAND = 0xFE;
+constexpr UInt32 SMU_RESPONSE_REJECTED_PREREQ = 0xFD;
+constexpr UInt32 SMU_RESPONSE_BUSY            = 0xFC;
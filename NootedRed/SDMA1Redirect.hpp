@@ -0,0 +1,116 @@
+// SDMA1 Redirection
+// Raven has a single SDMA engine, so everything the accelerator routes to SDMA1 is served by SDMA0.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <GPUDriversAMD/Accel/HWEngine.hpp>
+#include <IOKit/IOTypes.h>
+
+constexpr AMDHWEngineType redirectSDMA1(const AMDHWEngineType engineType)
+{
+    if (engineType == kAMDHWEngineTypeSDMA1) [[unlikely]] { return kAMDHWEngineTypeSDMA0; }
+    return engineType;
+}
+
+// Returns whether the slot was written, one that's already aliased is left alone so its cache line stays shared.
+template<typename T>
+constexpr bool aliasSDMA1Channel(T*& sdma1, T* const sdma0)
+{
+    if (sdma1 == sdma0) { return false; }
+    sdma1 = sdma0;
+    return true;
+}
+
+namespace SDMA1RedirectTests
+{
+
+    struct Engine
+    {
+        UInt32 releases{0};
+    };
+
+    // The accelerator's engine table, SDMA0 is the only engine NootedRed allocates.
+    struct EngineTable
+    {
+        Engine  sdma0{};
+        Engine* slots[kAMDHWEngineTypeMax]{};
+
+        constexpr EngineTable() { this->slots[kAMDHWEngineTypeSDMA0] = &this->sdma0; }
+
+        constexpr Engine* getHWChannel(const AMDHWEngineType engineType)
+        { return this->slots[redirectSDMA1(engineType)]; }
+
+        // Like the power and teardown paths, which visit every slot.
+        constexpr void releaseAll()
+        {
+            for (auto* const engine : this->slots) {
+                if (engine != nullptr) { engine->releases += 1; }
+            }
+        }
+    };
+
+    struct ChannelGroup
+    {
+        Engine* sdma0;
+        Engine* sdma1;
+        UInt32  writes;
+
+        constexpr void fix()
+        {
+            if (aliasSDMA1Channel(this->sdma1, this->sdma0)) { this->writes += 1; }
+        }
+    };
+
+    constexpr bool lookupsResolveToSDMA0()
+    {
+        EngineTable table{};
+        return table.getHWChannel(kAMDHWEngineTypeSDMA1) == &table.sdma0
+               && table.getHWChannel(kAMDHWEngineTypeSDMA0) == &table.sdma0
+               && table.getHWChannel(kAMDHWEngineTypeSDMA2) == nullptr;
+    }
+    static_assert(lookupsResolveToSDMA0());
+
+    constexpr bool teardownReleasesSDMA0Once()
+    {
+        EngineTable table{};
+        table.releaseAll();
+        return table.sdma0.releases == 1;
+    }
+    static_assert(teardownReleasesSDMA0Once());
+
+    // Why the SDMA1 slot isn't aliased once up front instead.
+    constexpr bool aliasedSlotReleasesTwice()
+    {
+        EngineTable table{};
+        table.slots[kAMDHWEngineTypeSDMA1] = &table.sdma0;
+        table.releaseAll();
+        return table.sdma0.releases == 2;
+    }
+    static_assert(aliasedSlotReleasesTwice());
+
+    constexpr bool groupIsWrittenOnce()
+    {
+        Engine       sdma0{};
+        ChannelGroup group{&sdma0, nullptr, 0};
+        for (UInt32 i = 0; i < 4; i += 1) { group.fix(); }
+        return group.sdma1 == &sdma0 && group.writes == 1;
+    }
+    static_assert(groupIsWrittenOnce());
+
+    // From 13.4 on, groups are created per task, long after the first ones were handed out.
+    constexpr bool laterGroupsAreFixedOnFirstUse()
+    {
+        Engine       sdma0{};
+        ChannelGroup first{&sdma0, nullptr, 0};
+        ChannelGroup second{&sdma0, nullptr, 0};
+        first.fix();
+        first.fix();
+        const bool untouched = second.sdma1 == nullptr;
+        second.fix();
+        return untouched && second.sdma1 == &sdma0 && first.writes == 1 && second.writes == 1;
+    }
+    static_assert(laterGroupsAreFixedOnFirstUse());
+
+}    // namespace SDMA1RedirectTests
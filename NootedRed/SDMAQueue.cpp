@@ -0,0 +1,193 @@
+// SDMA Copy Queue
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <GPUDriversAMD/RavenIPOffset.hpp>
+#include <Headers/kern_util.hpp>
+#include <NRed.hpp>
+#include <PenguinWizardry/Wait.hpp>
+#include <Regs/SDMA0.hpp>
+#include <SDMAQueue.hpp>
+
+static SDMAQueue moduleInstance;
+
+SDMAQueue& SDMAQueue::singleton() { return moduleInstance; }
+
+void SDMAQueue::init()
+{
+    if (this->lock != nullptr || !checkKernelArgument("-NRedSDMAQueue")) { return; }
+
+    this->lock = IOLockAlloc();
+    PANIC_COND(this->lock == nullptr, "SDMAQueue", "Failed to allocate lock");
+    this->startCall = thread_call_allocate(startThread, this);
+    PANIC_COND(this->startCall == nullptr, "SDMAQueue", "Failed to allocate start call");
+    SYSLOG("SDMAQueue", "Enabled");
+}
+
+void SDMAQueue::start()
+{
+    if (this->lock == nullptr) { return; }
+
+    IOLockLock(this->lock);
+    this->wanted = true;
+    IOLockUnlock(this->lock);
+    thread_call_enter(this->startCall);
+}
+
+void SDMAQueue::stop()
+{
+    if (this->lock == nullptr) { return; }
+
+    IOLockLock(this->lock);
+    this->wanted  = false;
+    this->running = false;
+    IOLockUnlock(this->lock);
+    thread_call_cancel(this->startCall);
+}
+
+IOReturn SDMAQueue::copy(UInt64 dst, UInt64 src, UInt64 bytes)
+{
+    if (this->lock == nullptr) { return kIOReturnNotReady; }
+
+    IOLockLock(this->lock);
+    auto ret = kIOReturnSuccess;
+    while (bytes != 0 && ret == kIOReturnSuccess) {
+        const auto batch = bytes < COPY_BATCH_BYTES ? bytes : COPY_BATCH_BYTES;
+        ret = this->submitLocked([=](SDMAPacketBuilder& builder) { builder.copyLinear(dst, src, batch); });
+        dst   += batch;
+        src   += batch;
+        bytes -= batch;
+    }
+    IOLockUnlock(this->lock);
+    return ret;
+}
+
+IOReturn SDMAQueue::fill(UInt64 dst, const UInt32 pattern, UInt64 bytes)
+{
+    if (this->lock == nullptr) { return kIOReturnNotReady; }
+
+    IOLockLock(this->lock);
+    auto ret = kIOReturnSuccess;
+    while (bytes != 0 && ret == kIOReturnSuccess) {
+        const auto batch = bytes < FILL_BATCH_BYTES ? bytes : FILL_BATCH_BYTES;
+        ret = this->submitLocked([=](SDMAPacketBuilder& builder) { builder.constantFill(dst, pattern, batch); });
+        dst   += batch;
+        bytes -= batch;
+    }
+    IOLockUnlock(this->lock);
+    return ret;
+}
+
+// Loaded the way KFD loads an SDMA RLC queue without the HWS, minus the doorbell, the write pointer is kicked directly.
+void SDMAQueue::programLocked()
+{
+    const auto& nred = NRed::singleton();
+    const auto  base = this->ring.getMCAddress();
+    const auto  cntl = (RING_SIZE_LOG2 << SDMA0_RLC_RB_CNTL_RB_SIZE_SHIFT) | (0 << SDMA0_RLC_RB_CNTL_RB_VMID_SHIFT);
+
+    nred.writeReg32(SDMA0_BASE_0 + SDMA0_RLC1_RB_CNTL, cntl);
+    nred.writeReg32(SDMA0_BASE_0 + SDMA0_RLC1_RB_RPTR, 0);
+    nred.writeReg32(SDMA0_BASE_0 + SDMA0_RLC1_RB_RPTR_HI, 0);
+    nred.writeReg32(SDMA0_BASE_0 + SDMA0_RLC1_MINOR_PTR_UPDATE, 1);
+    nred.writeReg32(SDMA0_BASE_0 + SDMA0_RLC1_RB_WPTR, 0);
+    nred.writeReg32(SDMA0_BASE_0 + SDMA0_RLC1_RB_WPTR_HI, 0);
+    nred.writeReg32(SDMA0_BASE_0 + SDMA0_RLC1_MINOR_PTR_UPDATE, 0);
+    nred.writeReg32(SDMA0_BASE_0 + SDMA0_RLC1_RB_BASE, static_cast<UInt32>(base >> 8));
+    nred.writeReg32(SDMA0_BASE_0 + SDMA0_RLC1_RB_BASE_HI, static_cast<UInt32>(base >> 40));
+    nred.writeReg32(SDMA0_BASE_0 + SDMA0_RLC1_RB_CNTL, cntl | SDMA0_RLC_RB_CNTL_RB_ENABLE);
+
+    this->wptr    = 0;
+    this->running = true;
+}
+
+void SDMAQueue::startThread(thread_call_param_t param0, thread_call_param_t)
+{
+    auto* const self = static_cast<SDMAQueue*>(param0);
+    const auto& nred = NRed::singleton();
+
+    const auto unhalted = [&nred] {
+        return (nred.readReg32(SDMA0_BASE_0 + SDMA0_F32_CNTL) & SDMA0_F32_CNTL_HALT) == 0;
+    };
+    if (!PenguinWizardry::waitFor(unhalted, START_TIMEOUT_MS).satisfied) {
+        SYSLOG("SDMAQueue", "F32 is still halted, not loading the queue");
+        return;
+    }
+
+    IOLockLock(self->lock);
+    if (!self->wanted) {
+        IOLockUnlock(self->lock);
+        return;
+    }
+    if (!self->ring.isAllocated() && !self->ring.allocate(PAGE_SIZE * 2)) {
+        IOLockUnlock(self->lock);
+        SYSLOG("SDMAQueue", "Failed to allocate the ring");
+        return;
+    }
+    self->programLocked();
+    const auto tested = self->tested;
+    IOLockUnlock(self->lock);
+
+    // Retried on every start until it passes, so a single slow power-up doesn't disable the queue for good.
+    if (tested) { return; }
+    const bool passed = self->selfTest();
+    SYSLOG_COND(!passed, "SDMAQueue", "Self-test failed, leaving the queue disabled until the next start");
+    NRed::singleton().setProp32("NRedSDMAQueue", passed);
+    IOLockLock(self->lock);
+    self->tested  = passed;
+    self->running = self->running && passed;
+    IOLockUnlock(self->lock);
+}
+
+// One submission at a time, so the ring is always drained when we get here and the staging buffer always fits.
+template<typename F>
+IOReturn SDMAQueue::submitLocked(const F& build)
+{
+    if (!this->running) { return kIOReturnNotReady; }
+
+    // CAIL's SDMA init resets every RLC queue, e.g. on resume, without going through `stop`.
+    if ((NRed::singleton().readReg32(SDMA0_BASE_0 + SDMA0_RLC1_RB_CNTL) & SDMA0_RLC_RB_CNTL_RB_ENABLE) == 0) {
+        this->programLocked();
+    }
+
+    UInt32            staging[STAGING_DWORDS];
+    SDMAPacketBuilder builder{staging, STAGING_DWORDS};
+    auto* const       ring    = static_cast<UInt32*>(this->ring.getBytes());
+    auto* const       fence   = reinterpret_cast<volatile UInt32*>(ring + RING_DWORDS);
+    const auto        fenceMC = this->ring.getMCAddress() + PAGE_SIZE;
+    const auto        seq     = ++this->sequence;
+    build(builder);
+    builder.fence(fenceMC, seq);
+    builder.pad();
+    if (!builder.isValid()) { return kIOReturnBadArgument; }
+
+    for (size_t i = 0; i < builder.getSize(); i += 1) { ring[(this->wptr + i) % RING_DWORDS] = staging[i]; }
+    this->wptr = static_cast<UInt32>((this->wptr + builder.getSize()) % RING_DWORDS);
+    __sync_synchronize();
+    NRed::singleton().writeReg32(SDMA0_BASE_0 + SDMA0_RLC1_RB_WPTR, this->wptr << 2);
+
+    if (!PenguinWizardry::waitFor([fence, seq] { return *fence == seq; }, FENCE_TIMEOUT_MS).satisfied) {
+        SYSLOG("SDMAQueue", "Fence %u timed out, stopping the queue", seq);
+        this->running = false;
+        return kIOReturnTimeout;
+    }
+    return kIOReturnSuccess;
+}
+
+// Fills the first half of a page, copies it to the second half and checks both on the CPU.
+bool SDMAQueue::selfTest()
+{
+    static constexpr UInt32 PATTERN = 0x4E526564;
+
+    AGPBuffer scratch{};
+    if (!scratch.allocate(PAGE_SIZE)) { return false; }
+
+    auto* const words = static_cast<volatile UInt32*>(scratch.getBytes());
+    const auto  half  = PAGE_SIZE / 2;
+    for (size_t i = 0; i < PAGE_SIZE / sizeof(UInt32); i += 1) { words[i] = 0; }
+    bool passed = this->fill(scratch.getMCAddress(), PATTERN, half) == kIOReturnSuccess
+                  && this->copy(scratch.getMCAddress() + half, scratch.getMCAddress(), half) == kIOReturnSuccess;
+    for (size_t i = 0; passed && i < PAGE_SIZE / sizeof(UInt32); i += 1) { passed = words[i] == PATTERN; }
+    scratch.free();
+    return passed;
+}
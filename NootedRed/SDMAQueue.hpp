@@ -0,0 +1,58 @@
+// SDMA Copy Queue
+// Copies and fills through SDMA0's RLC1 queue, which nothing else drives.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <AGPBuffer.hpp>
+#include <GPUDriversAMD/SDMAPacket.hpp>
+#include <IOKit/IOLocks.h>
+#include <IOKit/IOTypes.h>
+#include <kern/thread_call.h>
+
+class SDMAQueue
+{
+    static constexpr UInt32 RING_DWORDS      = 1024;    // One page.
+    static constexpr UInt32 RING_SIZE_LOG2   = 10;
+    static constexpr size_t STAGING_DWORDS   = 128;
+    static constexpr UInt32 BATCH_PACKETS    = 16;    // Leaves room for the fence and the padding.
+    static constexpr UInt32 FENCE_TIMEOUT_MS = 1000;
+    static constexpr UInt32 START_TIMEOUT_MS = 1000;
+    static constexpr UInt64 COPY_BATCH_BYTES = BATCH_PACKETS * UInt64{SDMA_COPY_MAX_BYTES};
+    static constexpr UInt64 FILL_BATCH_BYTES = BATCH_PACKETS * UInt64{SDMA_FILL_MAX_BYTES};
+
+    static_assert(RING_DWORDS == 1U << RING_SIZE_LOG2);
+    static_assert(STAGING_DWORDS < RING_DWORDS);
+    static_assert(SDMAPacketBuilder::copyLinearDWords(COPY_BATCH_BYTES) + 4 + 7 <= STAGING_DWORDS);
+    static_assert(SDMAPacketBuilder::constantFillDWords(FILL_BATCH_BYTES) + 4 + 7 <= STAGING_DWORDS);
+
+    IOLock*       lock{nullptr};
+    thread_call_t startCall{nullptr};
+    AGPBuffer     ring{};     // The ring's page, followed by the fence's.
+    UInt32        wptr{0};    // In dwords.
+    UInt32        sequence{0};
+    bool          wanted{false};    // Between `start` and `stop`.
+    bool          running{false};
+    bool          tested{false};    // Set once the self-test has passed.
+
+public:
+    static SDMAQueue& singleton();
+
+    // Opt-in through `-NRedSDMAQueue`, everything below fails with `kIOReturnNotReady` otherwise.
+    void init();
+    // Has to be called once SDMA0's F32 has been un-halted. Doesn't block, the queue is loaded on a thread call.
+    void start();
+    void stop();
+
+    // Addresses are MC addresses, e.g. from `AGPBuffer::getMCAddress`. Both block until SDMA is done.
+    IOReturn copy(UInt64 dst, UInt64 src, UInt64 bytes);
+    IOReturn fill(UInt64 dst, UInt32 pattern, UInt64 bytes);
+
+private:
+    void        programLocked();
+    static void startThread(thread_call_param_t param0, thread_call_param_t param1);
+    template<typename F>
+    IOReturn    submitLocked(const F& build);
+    bool        selfTest();
+};
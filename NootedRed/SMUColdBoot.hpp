@@ -0,0 +1,257 @@
+// SMU Cold Boot
+// The SMU power-up batches, and a model of the MP1 mailbox to replay them against without the hardware.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <GPUDriversAMD/CAIL/Result.hpp>
+#include <GPUDriversAMD/RenoirPPSMC.hpp>
+#include <IOKit/IOTypes.h>
+#include <Regs/SMU.hpp>
+#include <SMUQueue.hpp>
+
+constexpr SMUMessage kSMU10PowerUpMessages[] = {
+    {.message = PPSMC_MSG_ForceGfxContentSave, .optional = true},
+    {.message = PPSMC_MSG_PowerUpSdma},
+    {.message = PPSMC_MSG_PowerUpGfx},
+    {.message = PPSMC_MSG_PowerGateMmHub, .optional = true},
+};
+
+constexpr SMUMessage kSMU12PowerUpMessages[] = {
+    {.message = PPSMC_MSG_PowerUpSdma},
+    {.message = PPSMC_MSG_PowerUpGfx},
+    {.message = PPSMC_MSG_PowerGateAtHub, .optional = true},
+};
+
+// Answers like the MP1 firmware as far as the power-up paths can tell, one register access at a time.
+// Each message costs `latencyUs[message]` of simulated mailbox time.
+struct SMUMailboxModel
+{
+    const UInt32* latencyUs;                      // `SMUQueue::MESSAGE_COUNT` entries.
+    UInt64        unsupported{0};                 // One bit per message, answered with an unknown command.
+    UInt64        failing{0};                     // One bit per message, answered with a failure.
+    UInt32        firmwarePolls{0};               // `MP1_FIRMWARE_FLAGS` reads before the firmware is up.
+    UInt32        version{0};                     // What `PPSMC_MSG_GetSmuVersion` returns.
+    UInt32        argument{0};
+    UInt32        response{SMU_RESPONSE_OK};
+    UInt32        messages{0};
+    UInt64        mailboxUs{0};
+    bool          sdmaPowered{false};
+    bool          gfxPowered{false};
+
+    static_assert(SMUQueue::MESSAGE_COUNT <= 64);
+
+    constexpr UInt32 readRegister(const UInt32 reg)
+    {
+        switch (reg) {
+            case MP1_SMN_C2PMSG_82: return this->argument;
+            case MP1_SMN_C2PMSG_90: return this->response;
+            case MP1_FIRMWARE_FLAGS: {
+                if (this->firmwarePolls == 0) { return MP1_FIRMWARE_FLAGS_INTERRUPTS_ENABLED; }
+                this->firmwarePolls -= 1;
+                return 0;
+            }
+            default: return 0;
+        }
+    }
+
+    constexpr void writeRegister(const UInt32 reg, const UInt32 value)
+    {
+        switch (reg) {
+            case MP1_SMN_C2PMSG_66: {
+                this->handle(value);
+            } break;
+            case MP1_SMN_C2PMSG_82: {
+                this->argument = value;
+            } break;
+            case MP1_SMN_C2PMSG_90: {
+                this->response = value;
+            } break;
+            default: {
+            } break;
+        }
+    }
+
+private:
+    constexpr void handle(const UInt32 message)
+    {
+        this->messages += 1;
+        if (message >= SMUQueue::MESSAGE_COUNT) {
+            this->response = SMU_RESPONSE_UNKNOWN_COMMAND;
+            return;
+        }
+        this->mailboxUs += this->latencyUs[message];
+        if ((this->unsupported & (1ULL << message)) != 0) {
+            this->response = SMU_RESPONSE_UNKNOWN_COMMAND;
+            return;
+        }
+        if ((this->failing & (1ULL << message)) != 0) {
+            this->response = SMU_RESPONSE_FAILED;
+            return;
+        }
+        switch (message) {
+            case PPSMC_MSG_GetSmuVersion: {
+                this->argument = this->version;
+            } break;
+            case PPSMC_MSG_PowerUpSdma: {
+                this->sdmaPowered = true;
+            } break;
+            case PPSMC_MSG_PowerUpGfx: {
+                this->gfxPowered = true;
+            } break;
+            case PPSMC_MSG_DeviceDriverReset: {
+                this->sdmaPowered = false;
+                this->gfxPowered  = false;
+            } break;
+            default: {
+            } break;
+        }
+        this->response = SMU_RESPONSE_OK;
+    }
+};
+
+// The driver's half of a mailbox round trip, modelled on AMD's `smu90SendMessageWithParameter`, which is still what
+// sends on the hardware. The model answers right away, real firmware has to be polled until the response is non-zero.
+template<typename R>
+constexpr CAILResult smuMailboxExchange(R& regs, const UInt32 message, const UInt32 param, UInt32* const outParam)
+{
+    regs.writeRegister(MP1_SMN_C2PMSG_90, 0);
+    regs.writeRegister(MP1_SMN_C2PMSG_82, param);
+    regs.writeRegister(MP1_SMN_C2PMSG_66, message);
+    switch (regs.readRegister(MP1_SMN_C2PMSG_90)) {
+        case SMU_RESPONSE_OK: {
+            if (outParam != nullptr) { *outParam = regs.readRegister(MP1_SMN_C2PMSG_82); }
+            return kCAILResultOK;
+        }
+        case SMU_RESPONSE_UNKNOWN_COMMAND: return kCAILResultUnsupported;
+        case 0                           :
+        case SMU_RESPONSE_BUSY           : return kCAILResultNoResponse;
+        default                          : return kCAILResultFailed;
+    }
+}
+
+struct SMUColdBootRun
+{
+    CAILResult result;
+    UInt32     messages;
+    UInt64     mailboxUs;
+};
+
+constexpr UInt32 SMU_SIM_FIRMWARE_POLL_LIMIT = 1000;
+
+// Waits for the firmware like `smu12WaitForFwLoaded` if asked to, then sends the batch like `SMUQueue::sendBatch`.
+constexpr SMUColdBootRun simulateSMUColdBoot(SMUMailboxModel& model, const SMUMessage* const messages,
+                                             const size_t messageCount, const bool waitForFirmware)
+{
+    for (UInt32 polls = 0; waitForFirmware
+                           && (model.readRegister(MP1_FIRMWARE_FLAGS) & MP1_FIRMWARE_FLAGS_INTERRUPTS_ENABLED) == 0;
+         polls += 1)
+    {
+        if (polls == SMU_SIM_FIRMWARE_POLL_LIMIT) { return {kCAILResultNoResponse, model.messages, model.mailboxUs}; }
+    }
+    const auto result = runSMUBatch(messages, messageCount, [&model](const SMUMessage& message) {
+        return smuMailboxExchange(model, message.message, message.param, nullptr);
+    });
+    return {result, model.messages, model.mailboxUs};
+}
+
+template<size_t N>
+constexpr SMUColdBootRun simulateSMUColdBoot(SMUMailboxModel& model, const SMUMessage (&messages)[N],
+                                             const bool waitForFirmware)
+{ return simulateSMUColdBoot(model, messages, N, waitForFirmware); }
+
+namespace SMUColdBootTests
+{
+
+    struct NominalLatency
+    {
+        UInt32 us[SMUQueue::MESSAGE_COUNT]{};
+
+        constexpr NominalLatency()
+        {
+            for (auto& latency : this->us) { latency = 50; }
+            this->us[PPSMC_MSG_PowerUpSdma] = 500;
+            this->us[PPSMC_MSG_PowerUpGfx]  = 2000;
+        }
+    };
+
+    constexpr NominalLatency kNominal{};
+
+    constexpr bool smu10PowersEverythingUp()
+    {
+        SMUMailboxModel model{.latencyUs = kNominal.us};
+        const auto      run = simulateSMUColdBoot(model, kSMU10PowerUpMessages, false);
+        return run.result == kCAILResultOK && run.messages == 4 && run.mailboxUs == 2600 && model.sdmaPowered
+               && model.gfxPowered;
+    }
+    static_assert(smu10PowersEverythingUp());
+
+    // Older Raven firmware knows neither content saving nor MMHUB gating.
+    constexpr bool smu10SkipsOptionalMessages()
+    {
+        SMUMailboxModel model{
+            .latencyUs   = kNominal.us,
+            .unsupported = (1ULL << PPSMC_MSG_ForceGfxContentSave) | (1ULL << PPSMC_MSG_PowerGateMmHub),
+        };
+        const auto run = simulateSMUColdBoot(model, kSMU10PowerUpMessages, false);
+        return run.result == kCAILResultOK && run.messages == 4 && model.gfxPowered;
+    }
+    static_assert(smu10SkipsOptionalMessages());
+
+    constexpr bool smu12StopsAtFailure()
+    {
+        SMUMailboxModel model{.latencyUs = kNominal.us, .failing = 1ULL << PPSMC_MSG_PowerUpGfx};
+        const auto      run = simulateSMUColdBoot(model, kSMU12PowerUpMessages, true);
+        return run.result == kCAILResultFailed && run.messages == 2 && model.sdmaPowered && !model.gfxPowered;
+    }
+    static_assert(smu12StopsAtFailure());
+
+    constexpr bool smu12RequiredMessageMustBeSupported()
+    {
+        SMUMailboxModel model{.latencyUs = kNominal.us, .unsupported = 1ULL << PPSMC_MSG_PowerUpSdma};
+        const auto      run = simulateSMUColdBoot(model, kSMU12PowerUpMessages, true);
+        return run.result == kCAILResultUnsupported && run.messages == 1;
+    }
+    static_assert(smu12RequiredMessageMustBeSupported());
+
+    constexpr bool smu12WaitsForFirmware()
+    {
+        SMUMailboxModel model{.latencyUs = kNominal.us, .firmwarePolls = 3};
+        const auto      run = simulateSMUColdBoot(model, kSMU12PowerUpMessages, true);
+        return run.result == kCAILResultOK && run.messages == 3 && model.firmwarePolls == 0;
+    }
+    static_assert(smu12WaitsForFirmware());
+
+    constexpr bool smu12GivesUpOnFirmware()
+    {
+        SMUMailboxModel model{.latencyUs = kNominal.us, .firmwarePolls = SMU_SIM_FIRMWARE_POLL_LIMIT + 1};
+        const auto      run = simulateSMUColdBoot(model, kSMU12PowerUpMessages, true);
+        return run.result == kCAILResultNoResponse && run.messages == 0 && !model.sdmaPowered;
+    }
+    static_assert(smu12GivesUpOnFirmware());
+
+    constexpr bool resetThenPowerUp()
+    {
+        SMUMailboxModel model{.latencyUs = kNominal.us, .version = 0x2E4200};
+        UInt32          version = 0;
+        if (smuMailboxExchange(model, PPSMC_MSG_GetSmuVersion, 0, &version) != kCAILResultOK || version != 0x2E4200) {
+            return false;
+        }
+        if (simulateSMUColdBoot(model, kSMU10PowerUpMessages, false).result != kCAILResultOK) { return false; }
+        if (smuMailboxExchange(model, PPSMC_MSG_DeviceDriverReset, 0, nullptr) != kCAILResultOK || model.gfxPowered) {
+            return false;
+        }
+        const auto run = simulateSMUColdBoot(model, kSMU10PowerUpMessages, false);
+        return run.result == kCAILResultOK && run.messages == 10 && model.gfxPowered && model.sdmaPowered;
+    }
+    static_assert(resetThenPowerUp());
+
+    constexpr bool rejectsUnknownMessages()
+    {
+        SMUMailboxModel model{.latencyUs = kNominal.us};
+        return smuMailboxExchange(model, SMUQueue::MESSAGE_COUNT, 0, nullptr) == kCAILResultUnsupported;
+    }
+    static_assert(rejectsUnknownMessages());
+
+}    // namespace SMUColdBootTests
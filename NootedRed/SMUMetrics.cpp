@@ -0,0 +1,181 @@
+// SMU Metrics Sampler
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <GPUDriversAMD/RenoirPPSMC.hpp>
+#include <Headers/kern_util.hpp>
+#include <NRed.hpp>
+#include <PenguinWizardry/Stats.hpp>
+#include <SMUMetrics.hpp>
+#include <SMUQueue.hpp>
+#include <libkern/c++/OSDictionary.h>
+
+static SMUMetrics moduleInstance;
+
+SMUMetrics& SMUMetrics::singleton() { return moduleInstance; }
+
+void SMUMetrics::init()
+{
+    if (this->sampler.isEnabled() || !checkKernelArgument("-NRedSMUMetrics")) { return; }
+
+    this->sampler.init("SMUMetrics", this, &SMUMetrics::sampleLocked, SAMPLE_INTERVAL_MS);
+
+    SYSLOG("SMUMetrics", "Enabled");
+}
+
+void SMUMetrics::start(void* const ctx, const bool hasMetricsTable)
+{
+    if (!this->sampler.isEnabled()) { return; }
+
+    // The SMU DMAs the table in by MC address, Raven's SMU has no table to transfer.
+    if (hasMetricsTable && !this->table.isAllocated() && !this->table.allocate(PAGE_SIZE)) {
+        SYSLOG("SMUMetrics", "Failed to allocate metrics table, only querying clocks");
+    }
+
+    // The SMU forgets the table address across resets.
+    this->sampler.start([this, ctx, hasMetricsTable] {
+        this->ctx           = ctx;
+        this->useTable      = hasMetricsTable && this->table.isAllocated();
+        this->tableAddrSet  = false;
+        this->tableFailures = 0;
+        return true;
+    });
+}
+
+void SMUMetrics::stop()
+{
+    if (!this->sampler.isEnabled()) { return; }
+
+    this->sampler.stop([this] { this->ctx = nullptr; });
+}
+
+bool SMUMetrics::sampleTableLocked(SMUMetricsSample& sample)
+{
+    if (!this->tableAddrSet) {
+        const SMUMessage messages[] = {
+            {.message = PPSMC_MSG_SetDriverDramAddrHigh,
+             .param   = static_cast<UInt32>(this->table.getMCAddress() >> 32)},
+            {.message = PPSMC_MSG_SetDriverDramAddrLow, .param = static_cast<UInt32>(this->table.getMCAddress())},
+        };
+        if (SMUQueue::singleton().sendBatch(this->ctx, messages) != kCAILResultOK) { return false; }
+        this->tableAddrSet = true;
+    }
+
+    auto* const data = this->table.getBytes();
+    memset(data, 0xFF, sizeof(SMU12MetricsV0));
+    const auto res = SMUQueue::singleton().send(this->ctx, PPSMC_MSG_TransferTableSmu2Dram, SMU12_TABLE_SMU_METRICS);
+    if (res != kCAILResultOK) { return false; }
+    return parseSMU12Metrics(static_cast<const SMU12MetricsV0*>(data), this->table.getLength(), sample);
+}
+
+bool SMUMetrics::sampleMessagesLocked(SMUMetricsSample& sample)
+{
+    auto& queue = SMUQueue::singleton();
+    return queue.send(this->ctx, PPSMC_MSG_GetGfxclkFrequency, 0, &sample.gfxclkMHz) == kCAILResultOK
+           && queue.send(this->ctx, PPSMC_MSG_GetFclkFrequency, 0, &sample.memclkMHz) == kCAILResultOK;
+}
+
+void SMUMetrics::publish(const SMUMetricsSample& sample)
+{
+    auto* const stats = OSDictionary::withCapacity(5);
+    if (stats == nullptr) { return; }
+
+    PenguinWizardry::setStatsNumber(stats, "Core Clock(MHz)", sample.gfxclkMHz);
+    PenguinWizardry::setStatsNumber(stats, "Memory Clock(MHz)", sample.memclkMHz);
+    if (sample.hasTable) {
+        PenguinWizardry::setStatsNumber(stats, "GPU Activity(%)", sample.gfxActivity);
+        PenguinWizardry::setStatsNumber(stats, "Temperature(C)", sample.temperature);
+        PenguinWizardry::setStatsNumber(stats, "Total Power(W)", sample.socketPowerMW / 1000);
+    }
+    NRed::singleton().mergePerformanceStatistics(stats);
+    stats->release();
+}
+
+bool SMUMetrics::sampleLocked()
+{
+    SMUMetricsSample sample;
+    bool             sampled;
+    if (this->useTable) {
+        sampled = this->sampleTableLocked(sample);
+        if (sampled) { this->tableFailures = 0; }
+        else if (++this->tableFailures == TABLE_FAILURES_TO_GIVE_UP) {
+            SYSLOG("SMUMetrics", "Metrics table transfer keeps failing, only querying clocks from now on");
+            this->useTable = false;
+        }
+    }
+    else {
+        sampled = this->sampleMessagesLocked(sample);
+    }
+    if (sampled) { publish(sample); }
+    return true;
+}
+
+namespace SMUMetricsTests
+{
+
+    // A Renoir table captured under load, the fields the parser doesn't read are left zero.
+    constexpr SMU12MetricsV0 renoirUnderLoad()
+    {
+        SMU12MetricsV0 metrics{};
+        metrics.gfxclkFrequency    = 1750;
+        metrics.memclkFrequency    = 1600;
+        metrics.gfxActivity        = 9712;
+        metrics.gfxTemperature     = 6849;
+        metrics.currentSocketPower = 24500;
+        return metrics;
+    }
+
+    constexpr SMU12MetricsV0 kRenoirUnderLoad = renoirUnderLoad();
+
+    constexpr SMUMetricsSample parse(const SMU12MetricsV0& metrics, const size_t size, bool& accepted)
+    {
+        SMUMetricsSample sample{.gfxclkMHz = 1};
+        accepted = SMUMetrics::parseSMU12Metrics(&metrics, size, sample);
+        return sample;
+    }
+
+    constexpr bool convertsUnits()
+    {
+        bool       accepted = false;
+        const auto sample   = parse(kRenoirUnderLoad, sizeof(SMU12MetricsV0), accepted);
+        return accepted && sample.hasTable && sample.gfxclkMHz == 1750 && sample.memclkMHz == 1600
+               && sample.gfxActivity == 97 && sample.temperature == 68 && sample.socketPowerMW == 24500;
+    }
+    static_assert(convertsUnits());
+
+    // Newer firmware appends fields, a longer table is still read from the start.
+    constexpr bool acceptsLongerTables()
+    {
+        bool accepted = false;
+        return parse(kRenoirUnderLoad, PAGE_SIZE, accepted).gfxclkMHz == 1750 && accepted;
+    }
+    static_assert(acceptsLongerTables());
+
+    constexpr bool rejectsShortTables()
+    {
+        bool       accepted = true;
+        const auto sample   = parse(kRenoirUnderLoad, sizeof(SMU12MetricsV0) - 1, accepted);
+        return !accepted && sample.gfxclkMHz == 1 && !sample.hasTable;
+    }
+    static_assert(rejectsShortTables());
+
+    // `sampleTableLocked` fills the table with 0xFF before the transfer, so an SMU that never wrote it looks like this.
+    constexpr bool rejectsUntouchedTables()
+    {
+        auto metrics            = kRenoirUnderLoad;
+        metrics.gfxclkFrequency = 0xFFFF;
+        bool       accepted     = true;
+        const auto sample       = parse(metrics, sizeof(SMU12MetricsV0), accepted);
+        return !accepted && sample.gfxclkMHz == 1 && !sample.hasTable;
+    }
+    static_assert(rejectsUntouchedTables());
+
+    constexpr bool rejectsMissingTables()
+    {
+        SMUMetricsSample sample{};
+        return !SMUMetrics::parseSMU12Metrics(nullptr, sizeof(SMU12MetricsV0), sample) && !sample.hasTable;
+    }
+    static_assert(rejectsMissingTables());
+
+}    // namespace SMUMetricsTests
@@ -0,0 +1,65 @@
+// SMU Metrics Sampler
+// Periodically reads clocks, activity, temperature and power out of the SMU and
+// publishes them as the accelerator's `PerformanceStatistics`.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <AGPBuffer.hpp>
+#include <GPUDriversAMD/RenoirMetrics.hpp>
+#include <IOKit/IOTypes.h>
+#include <PenguinWizardry/PeriodicCall.hpp>
+
+struct SMUMetricsSample
+{
+    UInt32 gfxclkMHz{0};
+    UInt32 memclkMHz{0};       // FCLK when queried through messages.
+    bool   hasTable{false};    // Whether the fields below are valid.
+    UInt32 gfxActivity{0};     // %
+    UInt32 temperature{0};     // °C
+    UInt32 socketPowerMW{0};
+};
+
+class SMUMetrics
+{
+    static constexpr UInt32 SAMPLE_INTERVAL_MS        = 1000;
+    static constexpr UInt32 TABLE_FAILURES_TO_GIVE_UP = 3;
+
+    PenguinWizardry::PeriodicCall<SMUMetrics> sampler{};
+    AGPBuffer                                 table{};         // Only allocated for an SMU with a metrics table.
+    void*                                     ctx{nullptr};    // Non-null while the SMU is up.
+    bool                                      useTable{false};
+    bool                                      tableAddrSet{false};
+    UInt32                                    tableFailures{0};
+
+public:
+    static SMUMetrics& singleton();
+
+    // Opt-in through `-NRedSMUMetrics`, everything below is a no-op otherwise.
+    void init();
+    void start(void* ctx, bool hasMetricsTable);
+    void stop();
+
+    // Rejects truncated tables and ones the SMU never wrote to, `out` is left alone then.
+    static constexpr bool parseSMU12Metrics(const SMU12MetricsV0* const metrics, const size_t size,
+                                            SMUMetricsSample& out)
+    {
+        if (metrics == nullptr || size < sizeof(SMU12MetricsV0)) { return false; }
+        if (metrics->gfxclkFrequency == 0xFFFF) { return false; }    // Still the fill pattern.
+
+        out.gfxclkMHz     = metrics->gfxclkFrequency;
+        out.memclkMHz     = metrics->memclkFrequency;
+        out.hasTable      = true;
+        out.gfxActivity   = metrics->gfxActivity / 100;
+        out.temperature   = metrics->gfxTemperature / 100;
+        out.socketPowerMW = metrics->currentSocketPower;
+        return true;
+    }
+
+private:
+    bool        sampleLocked();
+    bool        sampleTableLocked(SMUMetricsSample& sample);
+    bool        sampleMessagesLocked(SMUMetricsSample& sample);
+    static void publish(const SMUMetricsSample& sample);
+};
@@ -0,0 +1,167 @@
+// Ordered SMU Mailbox Queue
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#include <Headers/kern_util.hpp>
+#include <PenguinWizardry/Uptime.hpp>
+#include <SMUQueue.hpp>
+
+static SMUQueue moduleInstance;
+
+SMUQueue& SMUQueue::singleton() { return moduleInstance; }
+
+void SMUQueue::init(const t_SendMessage sendMessage)
+{
+    if (this->sendMessage != nullptr) { return; }
+
+    this->sendMessage = sendMessage;
+    this->mailboxLock = IOLockAlloc();
+    PANIC_COND(this->mailboxLock == nullptr, "SMUQueue", "Failed to allocate mailbox lock");
+    this->entriesLock = IOLockAlloc();
+    PANIC_COND(this->entriesLock == nullptr, "SMUQueue", "Failed to allocate entries lock");
+    this->drainCall = thread_call_allocate(drainThread, this);
+    PANIC_COND(this->drainCall == nullptr, "SMUQueue", "Failed to allocate drain call");
+}
+
+CAILResult SMUQueue::send(void* const ctx, const UInt32 message, const UInt32 param, UInt32* const outParam)
+{
+    CompletionList completed;
+    IOLockLock(this->mailboxLock);
+    this->drainLocked(completed);
+    const auto res = this->sendLocked(ctx, message, param, outParam);
+    IOLockUnlock(this->mailboxLock);
+    completed.run();
+    return res;
+}
+
+CAILResult SMUQueue::sendBatch(void* const ctx, const SMUMessage* const messages, const size_t messageCount)
+{
+    CompletionList completed;
+    IOLockLock(this->mailboxLock);
+    this->drainLocked(completed);
+    const auto res = runSMUBatch(messages, messageCount, [this, ctx](const SMUMessage& message) {
+        return this->sendLocked(ctx, message.message, message.param, nullptr);
+    });
+    IOLockUnlock(this->mailboxLock);
+    completed.run();
+    return res;
+}
+
+bool SMUQueue::post(void* const ctx, const UInt32 message, const UInt32 param, const UInt32 timeoutMs,
+                    const t_Completion completion, void* const completionContext)
+{
+    IOLockLock(this->entriesLock);
+    const auto deadlineNs = PenguinWizardry::uptimeNs() + static_cast<UInt64>(timeoutMs) * 1000000;
+    if (completion == nullptr) {
+        for (size_t i = 0; i < this->count; i += 1) {
+            auto& entry = this->entries[(this->head + i) % CAPACITY];
+            if (entry.ctx == ctx && entry.message == message && entry.completion == nullptr) {
+                entry.param      = param;
+                entry.deadlineNs = deadlineNs;
+                IOLockUnlock(this->entriesLock);
+                return true;
+            }
+        }
+    }
+    if (this->count == CAPACITY) {
+        IOLockUnlock(this->entriesLock);
+        SYSLOG("SMUQueue", "Queue full, dropping message 0x%X", message);
+        return false;
+    }
+    this->entries[(this->head + this->count) % CAPACITY] = {ctx, message, param, deadlineNs, completion,
+                                                            completionContext};
+    this->count += 1;
+    IOLockUnlock(this->entriesLock);
+
+    thread_call_enter(this->drainCall);
+    return true;
+}
+
+// Taking the mailbox waits out a drain that is still sending.
+void SMUQueue::cancelAll()
+{
+    if (this->mailboxLock == nullptr) { return; }
+
+    CompletionList completed;
+    IOLockLock(this->mailboxLock);
+    thread_call_cancel(this->drainCall);
+    Entry entry;
+    for (size_t i = 0; i < CAPACITY && this->pop(entry); i += 1) {
+        if (entry.completion != nullptr) { completed.add(entry, kCAILResultNoResponse, 0); }
+    }
+    IOLockUnlock(this->mailboxLock);
+    completed.run();
+}
+
+UInt64 SMUQueue::getTotalMessages() const
+{
+    UInt64 ret = 0;
+    for (const auto& histogram : this->messageLatency) { ret += histogram.getCount(); }
+    return ret;
+}
+
+UInt64 SMUQueue::getTotalMailboxUs() const
+{
+    UInt64 ret = 0;
+    for (const auto& histogram : this->messageLatency) { ret += histogram.snapshot().totalUs; }
+    return ret;
+}
+
+bool SMUQueue::pop(Entry& entry)
+{
+    IOLockLock(this->entriesLock);
+    const bool hasEntry = this->count != 0;
+    if (hasEntry) {
+        entry        = this->entries[this->head];
+        this->head   = (this->head + 1) % CAPACITY;
+        this->count -= 1;
+    }
+    IOLockUnlock(this->entriesLock);
+    return hasEntry;
+}
+
+// Sends at most `CAPACITY` entries, whatever got posted meanwhile is left to the drain thread.
+void SMUQueue::drainLocked(CompletionList& completed)
+{
+    Entry entry;
+    for (size_t i = 0; i < CAPACITY && this->pop(entry); i += 1) {
+        UInt32 outParam = 0;
+        auto   res      = kCAILResultNoResponse;
+        if (PenguinWizardry::uptimeNs() <= entry.deadlineNs) {
+            res = this->sendLocked(entry.ctx, entry.message, entry.param, &outParam);
+        }
+        else {
+            DBGLOG("SMUQueue", "Message 0x%X expired before it could be sent", entry.message);
+        }
+        if (entry.completion != nullptr) { completed.add(entry, res, outParam); }
+        else {
+            SYSLOG_COND(res != kCAILResultOK && res != kCAILResultNoResponse, "SMUQueue",
+                        "Posted message 0x%X failed: 0x%X", entry.message, res);
+        }
+    }
+    IOLockLock(this->entriesLock);
+    if (this->count != 0) { thread_call_enter(this->drainCall); }
+    IOLockUnlock(this->entriesLock);
+}
+
+CAILResult SMUQueue::sendLocked(void* const ctx, const UInt32 message, const UInt32 param, UInt32* const outParam)
+{
+    const auto start = PenguinWizardry::uptimeUs();
+    const auto res   = this->sendMessage(ctx, message, param, outParam);
+    if (message < MESSAGE_COUNT) {
+        this->messageLatency[message].record(PenguinWizardry::uptimeUs() - start);
+        if (res != kCAILResultOK) { __atomic_fetch_add(&this->messageFailures[message], 1, __ATOMIC_RELAXED); }
+    }
+    return res;
+}
+
+void SMUQueue::drainThread(thread_call_param_t param0, thread_call_param_t)
+{
+    auto* const    self = static_cast<SMUQueue*>(param0);
+    CompletionList completed;
+    IOLockLock(self->mailboxLock);
+    self->drainLocked(completed);
+    IOLockUnlock(self->mailboxLock);
+    completed.run();
+}
@@ -0,0 +1,127 @@
+// Ordered SMU Mailbox Queue
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <GPUDriversAMD/CAIL/Result.hpp>
+#include <IOKit/IOLocks.h>
+#include <IOKit/IOTypes.h>
+#include <PenguinWizardry/LatencyHistogram.hpp>
+#include <kern/thread_call.h>
+
+struct SMUMessage
+{
+    UInt32 message;
+    UInt32 param{0};
+    bool   optional{false};    // `kCAILResultUnsupported` doesn't fail the batch.
+};
+
+// Shared by `SMUQueue::sendBatch` and the cold-boot simulator, messages are sent in order up to the first failure.
+template<typename F>
+constexpr CAILResult runSMUBatch(const SMUMessage* const messages, const size_t messageCount, const F& send)
+{
+    for (size_t i = 0; i < messageCount; i += 1) {
+        auto res = send(messages[i]);
+        if (res == kCAILResultUnsupported && messages[i].optional) { res = kCAILResultOK; }
+        if (res != kCAILResultOK) { return res; }
+    }
+    return kCAILResultOK;
+}
+
+// Orders NootedRed's own mailbox traffic, so our synchronous and posted messages are sent in submission order.
+// CAIL's internal `smu_9_0_send_message_with_parameter` calls don't go through here. They read the argument register
+// back after the call returns, so wrapping them couldn't make their round trips atomic anyway.
+// Posted messages are sent from a thread call and never block the caller.
+class SMUQueue
+{
+public:
+    using t_SendMessage = CAILResult (*)(void* ctx, UInt32 message, UInt32 param, UInt32* outParam);
+    // Runs once the queue has let go of the mailbox, so it may send or post again.
+    using t_Completion  = void (*)(void* context, UInt32 message, CAILResult result, UInt32 outParam);
+
+    static constexpr UInt32 MESSAGE_COUNT = 0x40;    // Covers every Raven and Renoir PPSMC message.
+
+private:
+    struct Entry
+    {
+        void*        ctx;
+        UInt32       message;
+        UInt32       param;
+        UInt64       deadlineNs;
+        t_Completion completion;
+        void*        completionContext;
+    };
+
+    static constexpr size_t CAPACITY = 16;
+
+    struct Completed
+    {
+        t_Completion completion;
+        void*        completionContext;
+        UInt32       message;
+        CAILResult   result;
+        UInt32       outParam;
+    };
+
+    // Completions are collected while the mailbox is held and only called after it has been let go.
+    struct CompletionList
+    {
+        Completed items[CAPACITY];
+        size_t    count{0};
+
+        void add(const Entry& entry, const CAILResult result, const UInt32 outParam)
+        { this->items[this->count++] = {entry.completion, entry.completionContext, entry.message, result, outParam}; }
+
+        void run() const
+        {
+            for (size_t i = 0; i < this->count; i += 1) {
+                const auto& item = this->items[i];
+                item.completion(item.completionContext, item.message, item.result, item.outParam);
+            }
+        }
+    };
+
+    t_SendMessage sendMessage{nullptr};
+    IOLock*       mailboxLock{nullptr};    // Held for the duration of a mailbox round trip.
+    IOLock*       entriesLock{nullptr};    // Only guards the ring below.
+    thread_call_t drainCall{nullptr};
+    Entry         entries[CAPACITY]{};
+    size_t        head{0}, count{0};
+
+    PenguinWizardry::LatencyHistogram messageLatency[MESSAGE_COUNT]{};
+    UInt64                            messageFailures[MESSAGE_COUNT]{};
+
+public:
+    static SMUQueue& singleton();
+
+    void init(t_SendMessage sendMessage);
+
+    CAILResult send(void* ctx, UInt32 message, UInt32 param = 0, UInt32* outParam = nullptr);
+    CAILResult sendBatch(void* ctx, const SMUMessage* messages, size_t messageCount);
+
+    template<const size_t N>
+    CAILResult sendBatch(void* const ctx, const SMUMessage (&messages)[N])
+    { return this->sendBatch(ctx, messages, N); }
+
+    // Pending posts of the same message without a completion are merged, the newest parameter wins.
+    // Posts still queued after `timeoutMs` are completed with `kCAILResultNoResponse` instead of being sent.
+    bool post(void* ctx, UInt32 message, UInt32 param, UInt32 timeoutMs, t_Completion completion = nullptr,
+              void* completionContext = nullptr);
+    // Has to be called whenever the SMU powers down, posts would otherwise be sent with a stale CAIL context.
+    void cancelAll();
+
+    const PenguinWizardry::LatencyHistogram& getMessageLatency(const UInt32 message) const
+    { return this->messageLatency[message]; }
+    UInt64 getMessageFailures(const UInt32 message) const
+    { return __atomic_load_n(&this->messageFailures[message], __ATOMIC_RELAXED); }
+    UInt64 getTotalMessages() const;
+    UInt64 getTotalMailboxUs() const;
+
+private:
+    bool       pop(Entry& entry);
+    void       drainLocked(CompletionList& completed);
+    CAILResult sendLocked(void* ctx, UInt32 message, UInt32 param, UInt32* outParam);
+
+    static void drainThread(thread_call_param_t param0, thread_call_param_t param1);
+};
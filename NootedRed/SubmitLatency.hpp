@@ -0,0 +1,76 @@
+// PM4 Submission Latency
+// Host-side cost of `submitCommandBuffer`, handed out for publishing at most once per interval.
+//
+// Copyright © 2025 ChefKiss. Licensed under the Thou Shalt Not Profit License version 1.5.
+// See LICENSE for details.
+
+#pragma once
+#include <IOKit/IOTypes.h>
+#include <PenguinWizardry/Atomic.hpp>
+#include <PenguinWizardry/LatencyHistogram.hpp>
+
+class SubmitLatency
+{
+    PenguinWizardry::LatencyHistogram histogram{};
+    UInt64                            publishedUs{0};
+
+public:
+    static constexpr UInt64 PUBLISH_INTERVAL_US = 1000000;
+
+    // Returns whether the caller should publish, only one of several racing submitters gets `true` per interval.
+    // A submitter that read the clock before the last publish doesn't count as being past the interval.
+    constexpr bool record(const UInt64 startUs, const UInt64 endUs)
+    {
+        this->histogram.record(endUs - startUs);
+        auto publishedUs = PenguinWizardry::atomicLoadRelaxed(this->publishedUs);
+        return endUs >= publishedUs + PUBLISH_INTERVAL_US
+               && PenguinWizardry::atomicCompareExchangeRelaxed(this->publishedUs, publishedUs, endUs);
+    }
+
+    constexpr const PenguinWizardry::LatencyHistogram& getHistogram() const { return this->histogram; }
+};
+
+namespace SubmitLatencyTests
+{
+    constexpr UInt64 SECOND_US = SubmitLatency::PUBLISH_INTERVAL_US;
+
+    constexpr bool publishesOncePerInterval()
+    {
+        SubmitLatency latency{};
+        return latency.record(SECOND_US, SECOND_US + 30) && !latency.record(SECOND_US + 100, SECOND_US + 180)
+               && !latency.record(2 * SECOND_US, 2 * SECOND_US + 29)
+               && latency.record(2 * SECOND_US + 20, 2 * SECOND_US + 45);
+    }
+    static_assert(publishesOncePerInterval());
+
+    // Nothing has been published before the first second of uptime.
+    constexpr bool waitsOutTheFirstInterval()
+    {
+        SubmitLatency latency{};
+        return !latency.record(500, 540) && latency.record(SECOND_US, SECOND_US + 1);
+    }
+    static_assert(waitsOutTheFirstInterval());
+
+    // The submitter that lost the race finishes with an older timestamp and must not move the publish time back.
+    constexpr bool ignoresStaleTimestamps()
+    {
+        SubmitLatency latency{};
+        return latency.record(3 * SECOND_US, 3 * SECOND_US + 50) && !latency.record(3 * SECOND_US - 10, 3 * SECOND_US)
+               && !latency.record(4 * SECOND_US, 4 * SECOND_US + 49)
+               && latency.record(4 * SECOND_US, 4 * SECOND_US + 50);
+    }
+    static_assert(ignoresStaleTimestamps());
+
+    constexpr bool recordsEverySubmission()
+    {
+        SubmitLatency latency{};
+        latency.record(SECOND_US, SECOND_US + 30);
+        latency.record(SECOND_US + 100, SECOND_US + 2100);
+        latency.record(SECOND_US + 200, SECOND_US + 200);
+        const auto snapshot = latency.getHistogram().snapshot();
+        return snapshot.count == 3 && snapshot.totalUs == 2030 && snapshot.maxUs == 2000 && snapshot.buckets[0] == 1
+               && snapshot.buckets[4] == 1 && snapshot.buckets[10] == 1;
+    }
+    static_assert(recordsEverySubmission());
+
+}    // namespace SubmitLatencyTests
@@ -6,11 +6,17 @@
 #include <AMDGFX9DCN1Display.hpp>
 #include <AMDGFX9DCN2Display.hpp>
 #include <AMDGFX9DCNDisplay.hpp>
+#include <ClockGating.hpp>
+#include <DPMBoost.hpp>
+#include <GCTopology.hpp>
 #include <GPUDriversAMD/Accel/HWDisplay.hpp>
 #include <GPUDriversAMD/Accel/HWEngine.hpp>
 #include <GPUDriversAMD/AddrLib.hpp>
 #include <GPUDriversAMD/FB/Attributes.hpp>
 #include <GPUDriversAMD/Family.hpp>
+#include <GfxAccess.hpp>
+#include <GfxOff.hpp>
+#include <HWLibs.hpp>
 #include <Headers/kern_mach.hpp>
 #include <Headers/kern_patcher.hpp>
 #include <Headers/kern_util.hpp>
@@ -18,8 +24,12 @@
 #include <NRed.hpp>
 #include <PenguinWizardry/KernelVersion.hpp>
 #include <PenguinWizardry/PatcherPlus.hpp>
+#include <PenguinWizardry/Uptime.hpp>
+#include <SDMA1Redirect.hpp>
+#include <SDMAQueue.hpp>
 #include <X5000.hpp>
 #include <libkern/OSTypes.h>
+#include <libkern/c++/OSDictionary.h>
 #include <libkern/c++/OSObject.h>
 #include <mach/i386/vm_param.h>
 #include <mach/i386/vm_types.h>
@@ -146,8 +156,20 @@ void X5000::processKext(KernelPatcher& patcher, const size_t id, const mach_vm_a
 
     NRed::singleton().hwLateInit();
 
+    // Experimental, lets the SDMA engine bring up its page queue so page table updates stop queueing behind copies.
+    this->sdmaPagingQueue = checkKernelArgument("-NRedSDMAPaging");
+    SYSLOG_COND(this->sdmaPagingQueue, "X5000", "Enabling the SDMA paging queue");
+
+    GfxAccessTracker::singleton().init();
+
+    if (checkKernelArgument("-NRedSubmitStats")) {
+        this->submitStatsCall = thread_call_allocate(publishSubmitStats, nullptr);
+        PANIC_COND(this->submitStatsCall == nullptr, "X5000", "Failed to allocate submit stats call");
+    }
+
     UInt32*           orgChannelTypes;
     mach_vm_address_t orgStartHWEngines;
+    mach_vm_address_t pm4SubmitCommandBuffer;
     void*             pm4ComputeChannelVT;
 
     PenguinWizardry::PatternSolveRequest solveRequests[] = {
@@ -163,7 +185,7 @@ void X5000::processKext(KernelPatcher& patcher, const size_t id, const mach_vm_a
          this->orgGFX9SetupAndInitializeHWCapabilities},
         {"__ZTV39AMDRadeonX5000_AMDGFX9PM4ComputeChannel", pm4ComputeChannelVT},
         {"__ZN30AMDRadeonX5000_AMDPM4HWChannel19submitCommandBufferEP30AMD_SUBMIT_COMMAND_BUFFER_INFO",
-         this->orgPM4SubmitCommandBuffer},
+         pm4SubmitCommandBuffer},
     };
     PANIC_COND(!PenguinWizardry::PatternSolveRequest::solveAll(patcher, id, solveRequests, slide, size), "X5000",
                "Failed to resolve symbols");
@@ -188,19 +210,24 @@ void X5000::processKext(KernelPatcher& patcher, const size_t id, const mach_vm_a
          kHwlConvertChipFamilyPattern},
         {"__ZN27AMDRadeonX5000_AMDHWDisplay14getDisplayInfoEjbbPvP17_FRAMEBUFFER_INFO", fixedGetDisplayInfo},
         {"__ZN33AMDRadeonX5000_AMDHWAlignManager214getSurfaceInfoEP24_AMD_SURFACE_INFO_STRUCT", fixedGetSurfaceInfo},
+        {"__ZN30AMDRadeonX5000_AMDPM4HWChannel19submitCommandBufferEP30AMD_SUBMIT_COMMAND_BUFFER_INFO",
+         wrapPM4SubmitCommandBuffer, this->orgPM4SubmitCommandBuffer},
     };
     PANIC_COND(!PenguinWizardry::PatternRouteRequest::routeAll(patcher, id, requests, slide, size), "X5000",
                "Failed to route symbols");
 
     if (currentKernelVersion() >= MACOS_11) {
-        PenguinWizardry::PatternSolveRequest solveRequest{"__ZN30AMDRadeonX5000_AMDGFX9Hardware15notifyGfxAccessEv",
-                                                          this->notifyGfxAccess};
-        PANIC_COND(!solveRequest.solve(patcher, id, slide, size), "X5000", "Failed to resolve notifyGfxAccess");
+        PenguinWizardry::PatternRouteRequest request{"__ZN30AMDRadeonX5000_AMDGFX9Hardware15notifyGfxAccessEv",
+                                                     wrapNotifyGfxAccess, this->notifyGfxAccess};
+        PANIC_COND(!request.route(patcher, id, slide, size), "X5000", "Failed to route notifyGfxAccess");
         PANIC_COND(MachInfo::setKernelWriting(true, KernelPatcher::kernelWriteLock) != KERN_SUCCESS, "X5000",
                    "Failed to enable kernel writing");
-        this->orgPM4SubmitCommandBuffer = this->hwChannelSubmitCommandBuffer(pm4ComputeChannelVT);
-        this->hwChannelSubmitCommandBuffer(pm4ComputeChannelVT) =
-            reinterpret_cast<mach_vm_address_t>(computeSubmitCommandBuffer);
+        // Compute takes its own reference, so it mustn't end up in the routed wrapper. If the channel inherits the base
+        // implementation, that is only reachable through the trampoline now.
+        auto&      computeSubmit            = this->hwChannelSubmitCommandBuffer(pm4ComputeChannelVT);
+        const bool inherited                = computeSubmit == pm4SubmitCommandBuffer;
+        this->orgComputeSubmitCommandBuffer = inherited ? this->orgPM4SubmitCommandBuffer : computeSubmit;
+        computeSubmit                       = reinterpret_cast<mach_vm_address_t>(computeSubmitCommandBuffer);
         MachInfo::setKernelWriting(false, KernelPatcher::kernelWriteLock);
     }
 
@@ -306,17 +333,20 @@ bool X5000::allocateHWEngines(void* const self)
     [[clang::suppress]] singleton().sdma0EngineField(self) = singleton().sdmaEngineMC->alloc();
 
     // No VCN? :-(
+    // AMDRadeonX5000 has no VCN engine class, only UVD and VCE ones, so there is nothing to allocate here.
+    // Decode would need an engine ported from AMDRadeonX6000, the firmware is already staged by HWLibs.
 
     return true;
 }
 
-// TODO: Replace with IP Discovery?
 void X5000::wrapSetupAndInitializeHWCapabilities(void* const self)
 {
     auto& seCount  = singleton().seCountField(self);
     auto& shCount  = singleton().shCountField(self);
     auto& hwMaxCUs = singleton().hwMaxCUsField(self);
 
+    // Every one of these has a single SE with a single SH, only the CUs get harvested. The accelerator wants the
+    // hardware maximums, so what survived harvesting is only published for diagnostics.
     seCount = 1;
     shCount = 1;
     if (NRed::singleton().getAttributes().isRenoir()) { hwMaxCUs = 8; }
@@ -326,23 +356,33 @@ void X5000::wrapSetupAndInitializeHWCapabilities(void* const self)
     else {
         hwMaxCUs = 11;
     }
+    const auto topology = GCTopology::read(1, 1, hwMaxCUs);
+    SYSLOG_COND(topology.cuCount == 0, "X5000", "No active CUs found");
+    DBGLOG("X5000", "%u of %u CUs active", topology.cuCount, hwMaxCUs);
+    topology.publish();
 
     FunctionCast(wrapSetupAndInitializeHWCapabilities, singleton().orgGFX9SetupAndInitializeHWCapabilities)(self);
 
+    // Every block has been brought up by now, including SDMA revisions which never go through `sdma412StartEngine`.
+    // The golden settings are checked first as clock gating rewrites some of the SDMA ones.
+    X5000HWLibs::singleton().verifyGoldenSettings();
+    ClockGating::singleton().apply();
+    SDMAQueue::singleton().start();
+
     singleton().supportedDisplayCountField(self) = 4;
     singleton().hasUVD0Field(self)               = false;
     singleton().hasVCEField(self)                = false;
-    singleton().hasVCN0Field(self)               = false;    // TODO
-    singleton().hasSDMAPagingQueueField(self)    = false;
+    singleton().hasVCN0Field(self)               = false;    // TODO: See `allocateHWEngines`.
+    singleton().hasSDMAPagingQueueField(self)    = singleton().sdmaPagingQueue;
     singleton().hasGetAllClockLimitsField(self)  = false;
     if (currentKernelVersion() >= MACOS_10_15) { singleton().dccDisplayableSupportField(self) = true; }
 }
 
-// TODO: Investigate why this is needed.
-void* X5000::wrapGetHWChannel(void* const self, AMDHWEngineType engineType, const UInt32 ringId)
+// The SDMA1 slot of the engine table is left empty on purpose. Aliasing it to the SDMA0 engine once would make every
+// loop over the table, teardown included, handle SDMA0 twice, so lookups get redirected instead.
+void* X5000::wrapGetHWChannel(void* const self, const AMDHWEngineType engineType, const UInt32 ringId)
 {
-    if (engineType == kAMDHWEngineTypeSDMA1) { engineType = kAMDHWEngineTypeSDMA0; }
-    return FunctionCast(wrapGetHWChannel, singleton().orgGetHWChannel)(self, engineType, ringId);
+    return FunctionCast(wrapGetHWChannel, singleton().orgGetHWChannel)(self, redirectSDMA1(engineType), ringId);
 }
 
 void X5000::initializeFamilyType(void* const self) { singleton().familyTypeField(self) = AMD_FAMILY_RAVEN; }
@@ -364,11 +404,11 @@ UInt64 X5000::wrapAdjustVRAMAddress(void* const self, const UInt64 addr)
 
 UInt32 X5000::returnZero() { return 0; }
 
-// Replaces SDMA1 field with SDMA0 because we don't have SDMA1
-// TODO: Investigate why this is needed.
+// Replaces SDMA1 field with SDMA0 because we don't have SDMA1.
+// Groups are handed out per task from 13.4 on, so there is no single point after which all of them exist.
 static void* fixAccelGroup(void* const group)
 {
-    if (group != nullptr) { getMember<void*>(group, 0x18) = getMember<void*>(group, 0x10); }
+    if (group != nullptr) { aliasSDMA1Channel(getMember<void*>(group, 0x18), getMember<void*>(group, 0x10)); }
     return group;
 }
 
@@ -405,10 +445,55 @@ UInt32 X5000::wrapHwlConvertChipFamily(void* const self, const UInt32 family, co
     return FunctionCast(wrapHwlConvertChipFamily, singleton().orgHwlConvertChipFamily)(self, family, revision);
 }
 
+// Every PM4 channel but compute, the graphics ring included, inherits this one.
+UInt32 X5000::wrapPM4SubmitCommandBuffer(void* const self, void* const info)
+{
+    const GfxOffGuard gfxOffGuard;
+    DPMBoost::singleton().noteSubmission();
+    return FunctionCast(wrapPM4SubmitCommandBuffer, singleton().orgPM4SubmitCommandBuffer)(self, info);
+}
+
+// Compute already has its own MEC queue through the PM4 engine's compute channel, separate from the graphics ring.
 UInt32 X5000::computeSubmitCommandBuffer(void* const self, void* const info)
 {
-    singleton().notifyGfxAccess(singleton().hwChannelHWInterfaceField(self));
-    return FunctionCast(computeSubmitCommandBuffer, singleton().orgPM4SubmitCommandBuffer)(self, info);
+    const GfxOffGuard gfxOffGuard;
+    const auto        start = PenguinWizardry::uptimeUs();
+    if (GfxAccessTracker::singleton().shouldNotify(start)) {
+        singleton().notifyGfxAccess(singleton().hwChannelHWInterfaceField(self));
+    }
+    DPMBoost::singleton().noteSubmission();
+    const auto ret = FunctionCast(computeSubmitCommandBuffer, singleton().orgComputeSubmitCommandBuffer)(self, info);
+
+    // Covers the access notification, waiting for ring space and writing the IB, not execution on the GPU.
+    auto& instance = singleton();
+    if (instance.submitStatsCall != nullptr
+        && instance.pm4ComputeSubmitLatency.record(start, PenguinWizardry::uptimeUs()))
+    {
+        thread_call_enter(instance.submitStatsCall);
+    }
+    return ret;
+}
+
+// The accelerator calls this before it touches GC outside of submissions.
+// The reference is dropped right away. The quiet period covers what comes next, and past it `GfxOff` still waits for
+// the GRBM to go idle.
+void X5000::wrapNotifyGfxAccess(void* const self)
+{
+    const GfxOffGuard gfxOffGuard;
+    FunctionCast(wrapNotifyGfxAccess, singleton().notifyGfxAccess)(self);
+}
+
+void X5000::publishSubmitStats(thread_call_param_t, thread_call_param_t)
+{
+    auto* const stats = OSDictionary::withCapacity(1);
+    if (stats == nullptr) { return; }
+    auto* const latency = singleton().pm4ComputeSubmitLatency.getHistogram().copyDictionary();
+    if (latency != nullptr) {
+        stats->setObject("PM4Compute", latency);
+        latency->release();
+    }
+    NRed::singleton().setProp("NRedSubmitStats", stats);
+    stats->release();
 }
 
 //  -- VRR was introduced on macOS Big Sur. --
@@ -465,6 +550,10 @@ namespace
             else {
                 const auto hTotal =
                     timingInfo.detailedInfo.v2.horizontalBlanking + timingInfo.detailedInfo.v2.horizontalActive;
+                if (hTotal != 0 && vTotalMin != 0) {
+                    DPMBoost::singleton().setRefreshRate(
+                        static_cast<UInt32>(pixelClock / (static_cast<UInt64>(hTotal) * vTotalMin)));
+                }
                 const auto hLineTimeNs = static_cast<UInt64>(hTotal) * 1000000000ULL / pixelClock;
                 UInt64     horizontalLineTime;
                 nanoseconds_to_absolutetime(hLineTimeNs, &horizontalLineTime);
@@ -13,34 +13,40 @@
 #include <Headers/kern_patcher.hpp>
 #include <IOKit/graphics/IOFramebuffer.h>
 #include <PenguinWizardry/ObjectField.hpp>
+#include <SubmitLatency.hpp>
+#include <kern/thread_call.h>
 
 class X5000
 {
-    ObjectField<void*>             pm4EngineField;
-    ObjectField<void*>             sdma0EngineField;
-    ObjectField<UInt32>            supportedDisplayCountField;
-    ObjectField<UInt32>            seCountField;
-    ObjectField<UInt32>            shCountField;
-    ObjectField<UInt32>            hwMaxCUsField;
-    ObjectField<bool>              hasUVD0Field;
-    ObjectField<bool>              hasVCEField;
-    ObjectField<bool>              hasVCN0Field;
-    ObjectField<bool>              hasSDMAPagingQueueField;
-    ObjectField<bool>              hasGetAllClockLimitsField;
-    ObjectField<bool>              dccDisplayableSupportField;
-    ObjectField<UInt32>            familyTypeField;
-    ObjectField<Gfx9ChipSettings>  chipSettingsField;
-    ObjectField<void*>             hwChannelHWInterfaceField;
-    ObjectField<mach_vm_address_t> hwChannelSubmitCommandBuffer;
-    OSMetaClass*                   pm4EngineMC{nullptr};
-    OSMetaClass*                   sdmaEngineMC{nullptr};
-    mach_vm_address_t              orgGFX9SetupAndInitializeHWCapabilities{0};
-    mach_vm_address_t              orgGetHWChannel{0};
-    mach_vm_address_t              orgAdjustVRAMAddress{0};
-    mach_vm_address_t              orgObtainAccelChannelGroup{0};
-    mach_vm_address_t              orgHwlConvertChipFamily{0};
-    mach_vm_address_t              orgPM4SubmitCommandBuffer{0};
-    void                           (*notifyGfxAccess)(void*){nullptr};
+    ObjectField<void*>                pm4EngineField;
+    ObjectField<void*>                sdma0EngineField;
+    ObjectField<UInt32>               supportedDisplayCountField;
+    ObjectField<UInt32>               seCountField;
+    ObjectField<UInt32>               shCountField;
+    ObjectField<UInt32>               hwMaxCUsField;
+    ObjectField<bool>                 hasUVD0Field;
+    ObjectField<bool>                 hasVCEField;
+    ObjectField<bool>                 hasVCN0Field;
+    ObjectField<bool>                 hasSDMAPagingQueueField;
+    ObjectField<bool>                 hasGetAllClockLimitsField;
+    ObjectField<bool>                 dccDisplayableSupportField;
+    ObjectField<UInt32>               familyTypeField;
+    ObjectField<Gfx9ChipSettings>     chipSettingsField;
+    ObjectField<void*>                hwChannelHWInterfaceField;
+    ObjectField<mach_vm_address_t>    hwChannelSubmitCommandBuffer;
+    OSMetaClass*                      pm4EngineMC{nullptr};
+    OSMetaClass*                      sdmaEngineMC{nullptr};
+    mach_vm_address_t                 orgGFX9SetupAndInitializeHWCapabilities{0};
+    mach_vm_address_t                 orgGetHWChannel{0};
+    mach_vm_address_t                 orgAdjustVRAMAddress{0};
+    mach_vm_address_t                 orgObtainAccelChannelGroup{0};
+    mach_vm_address_t                 orgHwlConvertChipFamily{0};
+    mach_vm_address_t                 orgPM4SubmitCommandBuffer{0};
+    mach_vm_address_t                 orgComputeSubmitCommandBuffer{0};
+    void                              (*notifyGfxAccess)(void*){nullptr};
+    bool                              sdmaPagingQueue{false};
+    SubmitLatency                     pm4ComputeSubmitLatency{};
+    thread_call_t                     submitStatsCall{nullptr};
 
 public:
     static X5000& singleton();
@@ -60,7 +66,10 @@ private:
     static void*  wrapObtainAccelChannelGroup(void* self, UInt32 priority);
     static void*  wrapObtainAccelChannelGroup1304(void* self, UInt32 priority, void* task);
     static UInt32 wrapHwlConvertChipFamily(void* self, UInt32 family, UInt32 revision);
+    static UInt32 wrapPM4SubmitCommandBuffer(void* self, void* info);
     static UInt32 computeSubmitCommandBuffer(void* self, void* info);
+    static void   wrapNotifyGfxAccess(void* self);
+    static void   publishSubmitStats(thread_call_param_t param0, thread_call_param_t param1);
     static bool   fixedGetDisplayInfo(AMDRadeonX5000_AMDHWDisplay* self, UInt32 fbIndex, bool isCRTEnabled,
                                       bool ignoreCRTOffsetCheck, IOFramebuffer* fb, FramebufferInfo* fbInfo);
     static void   fixedGetSurfaceInfo(AMDRadeonX5000_AMDHWAlignManager* self, AMD_SURFACE_INFO_STRUCT* pStruct);